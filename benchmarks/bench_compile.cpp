@@ -0,0 +1,68 @@
+/**
+ * Compile-time benchmark
+ *
+ * Times how long the compiler takes for one translation unit that uses the
+ * parser, compared with a TU that only includes the standard headers the
+ * parser needs:
+ * - std headers only (baseline)
+ * - #include "argparse.h" from this tree
+ * - #include "argparse.h" from $ARGPARSE_BASELINE/include, if set (e.g. a
+ *   checkout of an older release, to compare before and after a change)
+ *
+ * Run from the repository root. The compiler is taken from $CXX (default g++).
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+static const char* STD_TU =
+    "#include <string>\n#include <vector>\n#include <map>\n#include <variant>\n#include <functional>\n"
+    "int use(const std::map<std::string, std::variant<int, std::string>>& m) { return (int)m.size(); }\n";
+
+static const char* HEADER_TU =
+    "#include \"argparse.h\"\n"
+    "int use(ArgParse::ArgumentParser& p) {\n"
+    "    return p.get<int>(\"n\") + (int)p.get<bool>(\"v\") + (int)p.get_list<float>(\"f\").size() +\n"
+    "           (int)p.get_pos_args().size();\n"
+    "}\n";
+
+// Average wall time in ms of compiling source against include_dir, or -1 on failure
+static double time_compile(const std::string& compiler, const std::string& include_dir, const char* source, int reps) {
+    const std::string path = "build/bench_compile_tu.cpp";
+    std::ofstream(path) << source;
+    std::string cmd = compiler + " -std=c++17 -I" + include_dir + " -O2 -c " + path + " -o /dev/null";
+    if (std::system(cmd.c_str()) != 0) {     // warm-up, and check that it builds
+        return -1;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < reps; r++) {
+        if (std::system(cmd.c_str()) != 0) {
+            return -1;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / reps;
+}
+
+int main() {
+    const int reps = 5;
+    const char* env = std::getenv("CXX");
+    std::string compiler = env && *env ? env : "g++";
+
+    double t_std = time_compile(compiler, "include", STD_TU, reps);
+    double t_header = time_compile(compiler, "include", HEADER_TU, reps);
+
+    std::cout << "Compile time per TU (ms, " << compiler << ")" << std::endl;
+    std::cout << "  std headers only:       " << t_std << std::endl;
+    std::cout << "  #include argparse.h:    " << t_header << std::endl;
+
+    const char* baseline = std::getenv("ARGPARSE_BASELINE");
+    if (baseline && *baseline) {
+        double t_base = time_compile(compiler, std::string(baseline) + "/include", HEADER_TU, reps);
+        std::cout << "  baseline argparse.h:    " << t_base << std::endl;
+    }
+    return t_header < 0 ? 1 : 0;
+}
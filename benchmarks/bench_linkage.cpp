@@ -0,0 +1,59 @@
+/**
+ * Linkage benchmark: static vs shared library vs header-only
+ *
+ * The same program is built three ways by `make bench-linkage`:
+ * - linked against build/lib/libargparse.a (also the default `make benchmarks` build)
+ * - linked against build/lib/libargparse.so
+ * - compiled with -DARGPARSE_HEADER_ONLY -flto
+ *
+ * Each build reports its executable size, the time of a small parse_args()
+ * call and the time of a get<int>() lookup.
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <sys/stat.h>
+#include "argparse.h"
+
+#ifndef ARGPARSE_BENCH_VARIANT
+    #define ARGPARSE_BENCH_VARIANT "static"
+#endif
+
+using namespace ArgParse;
+
+int main(int, char** argv) {
+    const int parse_reps = 200000;
+    const int get_reps = 5000000;
+
+    ArgumentParser parser("bench");
+    parser.add_argument({"-v", "--verbose"}, "Verbose", BOOL);
+    parser.add_argument({"-n", "--count"}, "Count", INT, "1");
+    parser.add_argument({"--name"}, "Name", STR, "x");
+    parser.add_argument({"input"}, "Input", STR);
+    std::vector<std::string> args = {"bench", "-v", "--count", "42", "--name", "abc", "in.txt"};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < parse_reps; r++) {
+        if (parser.parse_args(args) != 0) {
+            std::cerr << "parse failed" << std::endl;
+            return 1;
+        }
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    long sum = 0;
+    for (int r = 0; r < get_reps; r++) {
+        sum += parser.get<int>("count");
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    struct stat st;
+    long size = stat(argv[0], &st) == 0 ? (long)st.st_size : -1;
+    double t_parse = std::chrono::duration<double, std::nano>(mid - start).count() / parse_reps;
+    double t_get = std::chrono::duration<double, std::nano>(end - mid).count() / get_reps;
+
+    std::cout << ARGPARSE_BENCH_VARIANT << ": binary " << size << " bytes, parse_args "
+              << t_parse << " ns, get<int> " << t_get << " ns" << (sum == 0 ? " (!)" : "") << std::endl;
+    return 0;
+}
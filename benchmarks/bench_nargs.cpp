@@ -0,0 +1,96 @@
+/**
+ * nargs list benchmark
+ *
+ * Parses an INT nargs="*" list of 1k to 10M values on one thread
+ * (set_parallel_conversion(0)) and reports:
+ * - parse_args time per value
+ * - the cost of collecting the value tokens the way the parser used to
+ *   (copying each token into a vector grown with push_back) compared with
+ *   the pre-count it does now (find the span, then size the result once)
+ */
+
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <chrono>
+#include "argparse.h"
+
+using namespace ArgParse;
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Previous token collection: copy tokens into a vector grown one at a time
+static size_t collect_push_back(const std::vector<std::string>& args, size_t first) {
+    std::vector<std::string> values;
+    for (size_t i = first; i < args.size() && args[i][0] != '-'; i++) {
+        values.push_back(args[i]);
+    }
+    std::vector<int> ints;
+    for (const auto& v : values) {
+        ints.push_back(0);
+        (void)v;
+    }
+    return ints.size();
+}
+
+// Current token collection: count the span, allocate the result once
+static size_t collect_precount(const std::vector<std::string>& args, size_t first) {
+    size_t count = 0;
+    while (first + count < args.size() && args[first + count][0] != '-') {
+        count++;
+    }
+    std::vector<int> ints;
+    ints.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        ints.push_back(0);
+    }
+    return ints.size();
+}
+
+int main() {
+    const size_t sizes[] = {1000, 10000, 100000, 1000000, 10000000};
+
+    printf("INT nargs list, one thread (ns per value)\n");
+    printf("  values     parse_args   collect:push_back   collect:pre-count\n");
+    for (size_t n : sizes) {
+        std::vector<std::string> args = {"bench", "--vals"};
+        args.reserve(n + 2);
+        for (size_t i = 0; i < n; i++) {
+            args.push_back(std::to_string(i % 100000));
+        }
+        const int reps = n >= 1000000 ? 1 : (int)(10000000 / n);
+
+        ArgumentParser parser("bench");
+        parser.add_argument({"--vals"}, "Values", INT, "", false, "", {}, "", "*");
+        parser.set_parallel_conversion(0);
+        parser.parse_args(args);     // warm-up
+
+        auto start = Clock::now();
+        for (int r = 0; r < reps; r++) {
+            if (parser.parse_args(args) != 0) {
+                fprintf(stderr, "parse failed\n");
+                return 1;
+            }
+        }
+        double t_parse = elapsed_ms(start) / reps;
+
+        size_t sink = 0;
+        start = Clock::now();
+        for (int r = 0; r < reps; r++) sink += collect_push_back(args, 2);
+        double t_push = elapsed_ms(start) / reps;
+
+        start = Clock::now();
+        for (int r = 0; r < reps; r++) sink += collect_precount(args, 2);
+        double t_count = elapsed_ms(start) / reps;
+
+        if (sink != 2 * n * reps) {
+            return 1;
+        }
+        printf("  %8zu   %10.2f   %17.2f   %17.2f\n", n, t_parse * 1e6 / n, t_push * 1e6 / n, t_count * 1e6 / n);
+    }
+    return 0;
+}
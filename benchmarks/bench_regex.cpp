@@ -0,0 +1,71 @@
+/**
+ * Regex validation benchmark
+ *
+ * Parses a 100k-element nargs list of ids three ways:
+ * - no validation (baseline)
+ * - set_pattern() (regex compiled once at registration)
+ * - set_validator() that builds the std::regex per value (what a naive
+ *   post-parse check ends up doing); run on a 10k subset as it is slow
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <regex>
+#include <chrono>
+#include "argparse.h"
+
+using namespace ArgParse;
+
+static const char* ID_PATTERN = "[a-z]{3}-[0-9]{6}";
+
+static double time_parse(ArgumentParser& parser, const std::vector<std::string>& args, int reps) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < reps; r++) {
+        if (parser.parse_args(args) != 0) {
+            std::cerr << "parse failed" << std::endl;
+            return -1;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / reps;
+}
+
+int main() {
+    const size_t num_ids = 100000;
+    const int reps = 5;
+
+    std::vector<std::string> args = {"bench", "--ids"};
+    args.reserve(num_ids + 2);
+    for (size_t i = 0; i < num_ids; i++) {
+        std::string num = std::to_string(100000 + i % 900000);
+        args.push_back("abc-" + num);
+    }
+
+    ArgumentParser plain("bench");
+    plain.add_argument({"--ids"}, "Ids", STR, "", false, "", {}, "", "+");
+
+    ArgumentParser precompiled("bench");
+    precompiled.add_argument({"--ids"}, "Ids", STR, "", false, "", {}, "", "+");
+    precompiled.set_pattern("ids", ID_PATTERN);
+
+    ArgumentParser recompiled("bench");
+    recompiled.add_argument({"--ids"}, "Ids", STR, "", false, "", {}, "", "+");
+    recompiled.set_validator("ids", [](const std::string& v) {
+        return std::regex_match(v, std::regex(ID_PATTERN));
+    });
+
+    double t_plain = time_parse(plain, args, reps);
+    double t_pre = time_parse(precompiled, args, reps);
+    const size_t num_small = 10000;
+    std::vector<std::string> small_args(args.begin(), args.begin() + 2 + num_small);
+    double t_plain_small = time_parse(plain, small_args, reps);
+    double t_re = time_parse(recompiled, small_args, 1);
+
+    std::cout << "Regex validation of " << num_ids << " ids (ms per parse)" << std::endl;
+    std::cout << "  no validation:          " << t_plain << std::endl;
+    std::cout << "  set_pattern (compiled): " << t_pre << "  (+" << (t_pre - t_plain) / num_ids * 1e6 << " ns/value)" << std::endl;
+    std::cout << "  regex built per value:  " << t_re * num_ids / num_small << "  (+"
+              << (t_re - t_plain_small) / num_small * 1e6 << " ns/value, extrapolated from " << num_small << " ids)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,5 @@
+#include "argparse.h"
+int use(ArgParse::ArgumentParser& p) {
+    return p.get<int>("n") + (int)p.get<bool>("v") + (int)p.get_list<float>("f").size() +
+           (int)p.get_pos_args().size();
+}
@@ -12,18 +12,33 @@
 #pragma once
 
 #include <string>
-#include <cstring>
+#include <string_view>
+#include <cstdio>
 #include <vector>
 #include <map>
 #include <variant>
+#include <functional>
+#include <memory>
 #include <exception>
 #include <stdexcept>
+#include <type_traits>
 
-/// Maximum length for string arguments (legacy - no longer used with std::string)
+/// Default error-buffer size of StaticParser (argparse_static.h); ArgumentParser itself uses std::string
 #ifndef ARGPARSE_MAX_STRLEN
     #define ARGPARSE_MAX_STRLEN 512
 #endif
 
+/// Header-only build: define ARGPARSE_HEADER_ONLY in every translation unit that
+/// includes this header (and do not link libargparse). The implementation
+/// (argparse/impl/ when installed, src/ with ARGPARSE_SOURCE_TREE) is then
+/// compiled inline, so the parser can be inlined and specialized per program
+/// (e.g. with -flto).
+#ifdef ARGPARSE_HEADER_ONLY
+    #define ARGPARSE_INLINE inline
+#else
+    #define ARGPARSE_INLINE
+#endif
+
 namespace ArgParse {
 
 /**
@@ -34,7 +49,27 @@ enum ArgType_t {
     BOOL,   // Boolean flag (true/false)
     INT,    // Integer number
     FLOAT,  // Floating-point number
-    STR     // String value
+    STR,    // String value
+    PATH,   // Filesystem path (stored as std::string, optional existence checks)
+    BLOB    // Binary data: "hex:...", "base64:..." or "@path" (stored encoded, decoded by get_blob)
+};
+
+/**
+ * @brief Checks applied to PATH argument values (combine with |)
+ */
+enum PathCheck_t {
+    PATH_EXISTS   = 1 << 0,     // Path must exist
+    PATH_FILE     = 1 << 1,     // Path must be a regular file
+    PATH_DIR      = 1 << 2,     // Path must be a directory
+    PATH_READABLE = 1 << 3      // Path must be readable by this process
+};
+
+/**
+ * @brief Result of an argument action callback
+ */
+enum ActionResult_t {
+    ACTION_CONTINUE,    // Keep parsing
+    ACTION_STOP         // Stop parsing immediately; parse_args() returns 1
 };
 
 /**
@@ -51,21 +86,246 @@ struct ArgVal_t {
 };
 
 /**
- * @brief Internal structure representing a command-line argument
+ * @brief Read-only memory-mapped file (opaque; mapped on first access)
+ */
+struct MappedFile;
+
+/**
+ * @brief Read-only view of an argument's content
+ *
+ * For `@path` and `file:path` values the file is memory-mapped on the first
+ * call to data(), size() or view(), never during parse_args(). Any other
+ * value is viewed in place and stays valid until the next parse_args().
+ *
+ * @throws ArgParseException from data()/size() if the file cannot be mapped
+ */
+class FileView {
+public:
+    FileView() = default;
+
+    const char* data() const;
+    size_t size() const;
+    std::string_view view() const { return std::string_view(data(), size()); }
+
+    /// True if the value referenced a file
+    bool is_file() const { return file_ != nullptr; }
+
+    /// Referenced file path (empty for inline values)
+    const std::string& path() const { return path_; }
+
+private:
+    friend class ArgumentParser;
+    std::shared_ptr<MappedFile> file_;
+    std::string path_;
+    std::string_view inline_;
+};
+
+/**
+ * @brief Read-only view of a memory-mapped numeric array (C++17 stand-in for std::span<const T>)
+ *
+ * Keeps the underlying mapping alive for as long as the view exists.
+ */
+template<typename T>
+class ArrayView {
+public:
+    ArrayView() = default;
+    ArrayView(std::shared_ptr<const MappedFile> owner, const T* data, size_t size)
+        : owner_(std::move(owner)), data_(data), size_(size) {}
+
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+private:
+    std::shared_ptr<const MappedFile> owner_;
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Precompiled value pattern (opaque; holds a std::regex in the library)
+ */
+struct Pattern_t;
+
+/**
+ * @brief Destination for everything the library prints (help, errors, print_args)
+ *
+ * Each call passes complete text (a whole help page or error line), so a
+ * sink needs no buffering of its own. The defaults write straight to file
+ * descriptors 1 and 2; the library itself never touches stdio or iostreams.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink();
+    virtual void write(std::string_view text) = 0;
+};
+
+/**
+ * @brief Sink writing to a file descriptor with write(2)
+ */
+class FdSink : public OutputSink {
+public:
+    explicit FdSink(int fd): fd_(fd) {}
+    ~FdSink() override;
+    void write(std::string_view text) override;
+private:
+    int fd_;
+};
+
+/**
+ * @brief Sink writing to a stdio stream
+ */
+class FileSink : public OutputSink {
+public:
+    explicit FileSink(FILE* file): file_(file) {}
+    ~FileSink() override;
+    void write(std::string_view text) override;
+private:
+    FILE* file_;
+};
+
+/**
+ * @brief Sink writing to any stream with write(const char*, n), e.g. std::ostream
+ *
+ * A template so the library does not depend on <ostream>:
+ * `ArgParse::StreamSink<std::ostream> sink(std::cerr);`
+ */
+template<typename Stream>
+class StreamSink : public OutputSink {
+public:
+    explicit StreamSink(Stream& stream): stream_(stream) {}
+    void write(std::string_view text) override { stream_.write(text.data(), text.size()); }
+private:
+    Stream& stream_;
+};
+
+/**
+ * @brief Sink collecting output in memory
+ */
+class BufferSink : public OutputSink {
+public:
+    ~BufferSink() override;
+    void write(std::string_view text) override;
+    const std::string& str() const { return buffer_; }
+    void clear() { buffer_.clear(); }
+private:
+    std::string buffer_;
+};
+
+/**
+ * @brief Parsed arguments of one command, detached from its parser
+ */
+struct CommandResult_t {
+    std::string command;                        // Command name ("" for the top-level options)
+    std::map<std::string, ArgVal_t> args;       // Parsed arguments by key
+    std::vector<std::string> pos_args;          // Raw positional arguments
+
+    /**
+     * @brief Get a parsed value by key
+     * @throws std::runtime_error if key not found
+     * @throws std::bad_variant_access on type mismatch
+     */
+    template<typename T>
+    T get(const std::string& key) const {
+        auto it = args.find(key);
+        if (it == args.end() || it->second.type == UNK) {
+            throw std::runtime_error("Argument key '" + key + "' not found in command '" + command + "'");
+        }
+        return std::get<T>(it->second.value);
+    }
+};
+
+/**
+ * @brief Per-thread free list of parse results for request-serving loops
+ *
+ * acquire() hands out a result from the free list (a hit) or a new one.
+ * The handle puts it back when destroyed, so a worker thread that parses
+ * one argv per request stops allocating results once the pool is warm.
+ * Pass it to ArgumentParser::parse_args(args, *handle). Nothing is locked:
+ * a pool and its handles belong to one thread, normally via local(). To
+ * pass values to another thread, move the CommandResult_t out of the handle.
+ *
+ * @example
+ * ```cpp
+ * auto result = ArgParse::ResultPool::local().acquire();
+ * if (parser.parse_args(request_argv, *result) == 0) {
+ *     serve(result->get<int>("port"));
+ * }   // result returns to the pool here
+ * ```
  */
-struct Argument_t {
-    std::vector<std::string> aliases;   // Argument aliases (e.g., "-v", "--verbose")
-    ArgType_t type      = UNK;          // Argument type
-    std::string key     = "";           // Internal key name
-    std::string help    = "";           // Help text
-    bool required       = false;        // Whether argument is required
-    bool is_positional  = false;        // Whether this is a positional argument
-    ArgVal_t defaultval = {UNK, false};    // Default value (initialized to UNK type with false)
-    std::vector<std::string> choices;   // Allowed values (empty = any value allowed)
-    std::string metavar = "";           // Display name for help (empty = auto-generate)
-    std::string nargs = "";             // Number of arguments: "", "?", "*", "+", or number
+class ResultPool {
+public:
+    /// Usage counters of one pool
+    struct Stats {
+        size_t acquired   = 0;      ///< acquire() calls
+        size_t hits       = 0;      ///< acquire() calls served from the free list
+        size_t in_use     = 0;      ///< Results currently borrowed from this pool
+        size_t high_water = 0;      ///< Most results borrowed at once
+        size_t free       = 0;      ///< Results waiting in the free list
+
+        double hit_rate() const { return acquired ? (double)hits / acquired : 0.0; }
+    };
+
+    /// Borrowed result; move-only, returned to its pool on destruction
+    class Handle {
+    public:
+        Handle() = default;
+        Handle(Handle&& other) noexcept: pool_(other.pool_), result_(std::move(other.result_)) {}
+        Handle& operator=(Handle&& other) noexcept {
+            reset();
+            pool_ = other.pool_;
+            result_ = std::move(other.result_);
+            return *this;
+        }
+        ~Handle() { reset(); }
+
+        CommandResult_t& operator*() const { return *result_; }
+        CommandResult_t* operator->() const { return result_.get(); }
+        CommandResult_t* get() const { return result_.get(); }
+        explicit operator bool() const { return result_ != nullptr; }
+
+        /// Return the result to the pool now
+        void reset() { if (result_) pool_->release(std::move(result_)); }
+
+    private:
+        friend class ResultPool;
+        Handle(ResultPool* pool, std::unique_ptr<CommandResult_t> result): pool_(pool), result_(std::move(result)) {}
+        ResultPool* pool_ = nullptr;
+        std::unique_ptr<CommandResult_t> result_;
+    };
+
+    /**
+     * @param max_free Results kept in the free list; more are freed on release
+     */
+    explicit ResultPool(size_t max_free = 64): max_free_(max_free) {}
+    ResultPool(const ResultPool&) = delete;
+    ResultPool& operator=(const ResultPool&) = delete;
+
+    /// Pool of the calling thread
+    static ResultPool& local();
+
+    /// Borrow a result; a recycled one has its entries unset until parse_args() fills it
+    Handle acquire();
+
+    /// Take a result back and reset it in place: entries are marked unset (UNK), capacity is kept
+    void release(std::unique_ptr<CommandResult_t> result);
+
+    Stats stats() const;
+
+private:
+    std::vector<std::unique_ptr<CommandResult_t>> free_;
+    size_t max_free_;
+    Stats stats_;
 };
 
+/**
+ * @brief Internal structure representing a command-line argument (defined in the library)
+ */
+struct Argument_t;
+
 /**
  * @brief Convert alias to internal key name
  * @param alias Argument alias (e.g., "--opt-name")
@@ -88,10 +348,117 @@ std::string alias2key(const std::string& alias);
  * - BOOL: "true", "1", "false", "0"
  * - INT: Integer numbers (including negative)
  * - FLOAT: Floating-point numbers (including negative)
- * - STR: Any string (always valid)
+ * - STR, PATH: Any string (always valid)
+ * - BLOB: "hex:" + even number of hex digits, "base64:" + padded base64,
+ *   or a file reference ("@path", "file:path")
  */
 bool is_valid_type(const std::string& str, ArgType_t type);
 
+/**
+ * @brief Whether str is an INT value: optional '-' followed by decimal digits
+ *
+ * No leading blanks, '+' sign or other bases. Shared with StaticParser so
+ * both parsers accept the same tokens.
+ */
+inline bool is_int_token(std::string_view str) {
+    size_t start = !str.empty() && str[0] == '-' ? 1 : 0;
+    if (start == str.size()) return false;
+    for (size_t i = start; i < str.size(); i++) {
+        if (str[i] < '0' || str[i] > '9') return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Whether str is a FLOAT value: optional '-', digits and at most one '.' (not last)
+ *
+ * No exponent, "inf" or "nan". A long enough token still overflows float;
+ * both parsers reject values strtof reports as out of range, so every
+ * accepted value is finite.
+ */
+inline bool is_float_token(std::string_view str) {
+    size_t start = !str.empty() && str[0] == '-' ? 1 : 0;
+    if (start == str.size()) return false;
+    bool decimal_point_found = false;
+    for (size_t i = start; i < str.size(); i++) {
+        if (str[i] >= '0' && str[i] <= '9') continue;
+        if (str[i] != '.' || decimal_point_found || i == str.size() - 1) return false;
+        decimal_point_found = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Incremental POSIX-shell-style command line tokenizer
+ *
+ * Follows the quoting rules of `sh` word splitting (as Python's
+ * `shlex.split`): whitespace separates tokens, single quotes are literal,
+ * double quotes allow `\"`, `\\`, `\$`, `` \` `` escapes, and a backslash
+ * outside quotes escapes the next character. Input can arrive in chunks;
+ * quotes and escapes may span chunk boundaries.
+ *
+ * @example
+ * ```cpp
+ * ArgParse::CommandTokenizer tok;
+ * std::vector<std::string> tokens;
+ * tok.feed("--name 'hello wo", tokens);
+ * tok.feed("rld' -v", tokens);
+ * tok.finish(tokens);     // {"--name", "hello world", "-v"}
+ * ```
+ */
+class CommandTokenizer {
+public:
+    /**
+     * @brief Tokenize a chunk of input
+     * @param chunk Next piece of the command line
+     * @param tokens Completed tokens are appended here
+     */
+    void feed(std::string_view chunk, std::vector<std::string>& tokens);
+
+    /**
+     * @brief End of input: emit the pending token, if any
+     * @throws ArgParseException on an unterminated quote or trailing backslash
+     */
+    void finish(std::vector<std::string>& tokens);
+
+    /**
+     * @brief Tokenize up to the end of the next command
+     * @param chunk Input; the consumed prefix is removed from it
+     * @param tokens Completed tokens are appended here
+     * @return true if an unquoted newline ended a command (it is consumed);
+     *         false if the whole chunk was consumed without one
+     *
+     * Quoted newlines stay in their token and backslash-newline continues
+     * the line, as in a shell script.
+     */
+    bool feed_command(std::string_view& chunk, std::vector<std::string>& tokens);
+
+    /**
+     * @brief Discard any partial token and quoting state
+     */
+    void reset();
+
+    /// Whether a token or quote is open (a command is in progress)
+    bool pending() const { return state_ != SPACE || started_; }
+
+private:
+    enum State_t { SPACE, WORD, SQUOTE, DQUOTE, ESCAPE, DQUOTE_ESCAPE };
+
+    /// Lexer loop; stops after an unquoted newline if stop_at_newline (setting ended)
+    const char* scan(const char* p, const char* end, std::vector<std::string>& tokens, bool stop_at_newline, bool& ended);
+    State_t state_ = SPACE;     ///< Current lexer state
+    std::string current_;       ///< Token being built
+    bool started_ = false;      ///< Whether current_ is a token (it may be an empty quoted one)
+};
+
+/**
+ * @brief Split a command string into arguments with POSIX shell quoting rules
+ * @param line Command line (e.g., "--name 'John Smith' -v")
+ * @return Unquoted, unescaped tokens
+ * @throws ArgParseException on an unterminated quote or trailing backslash
+ */
+std::vector<std::string> split_command_line(std::string_view line);
+
 /**
  * @brief Main argument parser class
  * 
@@ -119,16 +486,124 @@ bool is_valid_type(const std::string& str, ArgType_t type);
  */
 class ArgumentParser {
 private:
-    std::string prog_name_;     ///< Program name
-    std::string description_;   ///< Program description
-    std::string epilog_;        ///< Additional help text
-    
-    std::vector<Argument_t>         arg_list_;          ///< List of defined arguments
-    std::vector<Argument_t>         pos_arg_list_;      ///< List of positional arguments (for ordering)
-    std::vector<std::string>        args_;              ///< Raw command-line arguments
+    /// Argument table, indexes, groups, help caches and parse state (defined in the library)
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
     std::map<std::string, ArgVal_t> parsed_args_;       ///< Parsed arguments (both optional and positional)
     std::vector<std::string>        parsed_pos_args_;   ///< Raw positional arguments (for backward compatibility)
 
+    OutputSink* out_ = nullptr;         ///< Help and print_args output (null = fd 1)
+    OutputSink* err_ = nullptr;         ///< Error messages (null = fd 2)
+
+    /**
+     * @brief Rendered help block for arg_list_[idx], cached
+     */
+    const std::string& help_entry(size_t idx) const;
+
+    /**
+     * @brief Build the inverted index used by print_help(pattern)
+     */
+    void build_help_index() const;
+
+    /**
+     * @brief Help text for key from the help resource ("" if none)
+     *
+     * Maps and indexes the resource on first use. An unreadable file is
+     * treated as empty.
+     */
+    std::string_view resource_help(const std::string& key) const;
+
+    /**
+     * @brief Run a lazy group's registrar (no-op once loaded)
+     * @throws ArgParseException if the registrar adds positional arguments
+     */
+    void load_group(size_t idx);
+
+    /**
+     * @brief Help section for groups_[idx]: heading, description and entries
+     */
+    std::string group_help(size_t idx) const;
+
+    /**
+     * @brief Store the initial value of an argument in parsed_args_
+     * @return true if the value is an explicit default (counts as provided)
+     */
+    bool init_default(const Argument_t& a);
+
+    /**
+     * @brief Count the value tokens after args[i] for parse_chain()
+     * @return 0 unless args[i] is one of this parser's non-BOOL options;
+     *         variable-length lists stop at the delimiter or a command name
+     */
+    size_t option_span(const std::vector<std::string>& args, size_t i, const std::string& delimiter);
+
+    /**
+     * @brief Mark every parsed value unset, keeping the map nodes for reuse
+     */
+    void reset_parsed();
+
+    /**
+     * @brief Erase entries left unset by reset_parsed()
+     */
+    void drop_unset();
+
+    /// Binary array mapped for an argument during parsing
+    struct ArrayData_t {
+        std::shared_ptr<const MappedFile> file;     ///< Keeps the mapping alive
+        const void* data = nullptr;                 ///< First element
+        size_t count = 0;                           ///< Number of elements
+        ArgType_t type = UNK;                       ///< INT or FLOAT
+    };
+
+    /**
+     * @brief Read the list files of all set_files_from() arguments
+     * @throws ArgParseException on unreadable lists or visitor errors
+     */
+    void load_file_lists();
+
+    /**
+     * @brief Map and validate binary array files for all array arguments
+     * @throws ArgParseException on unreadable files or malformed headers
+     */
+    void load_arrays();
+
+    /**
+     * @brief Look up a mapped array and check its element type
+     * @throws std::runtime_error if key not found or type mismatch
+     */
+    const ArrayData_t& find_array(const std::string& key, ArgType_t type) const;
+
+    /**
+     * @brief Look up a defined argument by key
+     * @throws ArgParseException if no argument uses this key
+     */
+    Argument_t& find_argument(const std::string& key);
+
+    /**
+     * @brief Look up a parsed value by key
+     * @throws std::runtime_error if key not found
+     */
+    const ArgVal_t& find_value(const std::string& key) const;
+
+    /// Name of a value type in get() error messages
+    template<typename T> static constexpr const char* value_type_name() {
+        if constexpr (std::is_same_v<T, bool>) return "bool";
+        else if constexpr (std::is_same_v<T, int>) return "int";
+        else if constexpr (std::is_same_v<T, float>) return "float";
+        else if constexpr (std::is_same_v<T, std::string>) return "std::string";
+        else if constexpr (std::is_same_v<T, std::vector<int>>) return "std::vector<int>";
+        else if constexpr (std::is_same_v<T, std::vector<float>>) return "std::vector<float>";
+        else if constexpr (std::is_same_v<T, std::vector<std::string>>) return "std::vector<std::string>";
+        else return "unsupported type";
+    }
+
+    /**
+     * @brief Report a get() type mismatch (kept out of line)
+     * @throws std::runtime_error always
+     */
+    [[noreturn]] static void throw_type_mismatch(const std::string& key, const char* requested, const ArgVal_t& value);
+
 public:
     /**
      * @brief Construct a new Argument Parser
@@ -140,26 +615,29 @@ public:
                    const std::string& description = "", 
                    const std::string& epilog = "");
     
-    /**
-     * @brief Destructor
-     */
-    ~ArgumentParser() = default;
+    ArgumentParser(const ArgumentParser& other);
+    ArgumentParser(ArgumentParser&& other) noexcept;
+    ArgumentParser& operator=(const ArgumentParser& other);
+    ArgumentParser& operator=(ArgumentParser&& other) noexcept;
+    ~ArgumentParser();
 
     /**
      * @brief Add a command-line argument
      * @param aliases List of argument names (e.g., {"-v", "--verbose"})
      * @param help Help text for this argument
-     * @param type Argument type (BOOL, INT, FLOAT, STR)
+     * @param type Argument type (BOOL, INT, FLOAT, STR, PATH, BLOB)
      * @param defaultval Default value as string
      * @param required Whether this argument is required
      * @param key Custom internal key name (auto-generated if empty)
      * @param choices Allowed values (empty = any value allowed)
      * @param metavar Display name for help (empty = auto-generate)
      * @param nargs Number of arguments: "", "?", "*", "+", or number
+     * @return The argument's key, as passed to get() (a positional's name,
+     *         else key, else the longest alias, e.g. "--dry-run" -> "dry_run")
      * 
      * @throws ArgParseException if aliases is empty or invalid
      */
-    void add_argument(const std::vector<std::string>& aliases, 
+    std::string add_argument(const std::vector<std::string>& aliases, 
                       const std::string& help = "", 
                       ArgType_t type = BOOL, 
                       const std::string& defaultval = "", 
@@ -169,19 +647,294 @@ public:
                       const std::string& metavar = "",
                       const std::string& nargs = "");
 
+    /**
+     * @brief Restrict a numeric argument to an inclusive range
+     * @param key Argument key (e.g., "port")
+     * @param min_val Smallest accepted value
+     * @param max_val Largest accepted value
+     * @param step If non-zero, values must equal min_val + k*step
+     *
+     * The check runs while each token is converted, for single values and
+     * every element of an nargs list alike.
+     *
+     * @throws ArgParseException if key is unknown, the argument is not INT/FLOAT,
+     *         or min_val > max_val
+     */
+    void set_range(const std::string& key, double min_val, double max_val, double step = 0);
+
+    /**
+     * @brief Set only a lower bound for a numeric argument
+     * @throws ArgParseException if key is unknown or the argument is not INT/FLOAT
+     */
+    void set_min(const std::string& key, double min_val);
+
+    /**
+     * @brief Set only an upper bound for a numeric argument
+     * @throws ArgParseException if key is unknown or the argument is not INT/FLOAT
+     */
+    void set_max(const std::string& key, double max_val);
+
+    /**
+     * @brief Attach a custom predicate run on every raw value of an argument
+     * @param key Argument key
+     * @param validator Returns false to reject the value
+     * @param message Reason reported on rejection (e.g., "must be even")
+     *
+     * @example
+     * ```cpp
+     * parser.set_validator("threads", [](const std::string& v) { return std::stoi(v) % 2 == 0; }, "must be even");
+     * ```
+     */
+    void set_validator(const std::string& key,
+                       std::function<bool(const std::string&)> validator,
+                       const std::string& message = "");
+
+    /**
+     * @brief Require every value of a STR argument to fully match a regex
+     * @param key Argument key
+     * @param pattern ECMAScript regular expression
+     *
+     * The pattern is compiled once here and shared by all later parses.
+     *
+     * @throws ArgParseException if key is unknown, the argument is not STR,
+     *         or the pattern does not compile
+     */
+    void set_pattern(const std::string& key, const std::string& pattern);
+
+    /**
+     * @brief Enable filesystem checks for a PATH argument
+     * @param key Argument key
+     * @param checks PathCheck_t flags, e.g. PATH_FILE | PATH_READABLE
+     *
+     * Large nargs lists are checked in parallel batches. Every failing path
+     * is reported in a single error rather than stopping at the first one.
+     *
+     * @throws ArgParseException if key is unknown or the argument is not PATH
+     */
+    void set_path_checks(const std::string& key, int checks);
+
+    /**
+     * @brief Expand glob patterns in the values of a STR/PATH list argument
+     * @param key Argument key (argument must use nargs)
+     * @param max_matches Error out if one pattern matches more paths (0 = unlimited)
+     *
+     * Supports `*`, `?` and `[...]` within a path component, and a `**`
+     * component matching any number of directories. Matches of each pattern
+     * are sorted; values without wildcards pass through unchanged.
+     * A pattern that matches nothing is an error.
+     *
+     * @throws ArgParseException if key is unknown or the argument is not a STR/PATH list
+     */
+    void set_glob(const std::string& key, size_t max_matches = 0);
+
+    /**
+     * @brief Convert long nargs lists on several threads
+     * @param min_values Lists with at least this many values are split into
+     *        chunks converted in parallel (0 = always convert on one thread)
+     * @param threads Number of threads (0 = std::thread::hardware_concurrency())
+     *
+     * Each chunk is validated and converted directly into the final vector.
+     * Values and error messages are the same as with serial conversion: the
+     * error reported is the one for the first invalid value. Arguments with
+     * a custom validator (set_validator) are always converted serially.
+     * Chunks whose thread cannot be created are converted on the calling
+     * thread. The default threshold is 65536 values.
+     */
+    void set_parallel_conversion(size_t min_values, unsigned threads = 0);
+
+    /**
+     * @brief Treat a STR/PATH argument's value as a binary numeric array file
+     * @param key Argument key
+     * @param elem_type INT (int32) or FLOAT (float32)
+     * @param check_finite Scan FLOAT data for NaN/Inf during parsing
+     *
+     * Accepts `.npy` files (little-endian '<i4' / '<f4') or raw little-endian
+     * data. Parsing maps the file and validates only the header and length,
+     * unless check_finite or a range (set_range) asks for a full scan.
+     * Multi-dimensional .npy arrays are exposed flat, in file order.
+     *
+     * @throws ArgParseException if key is unknown, the argument is not STR/PATH,
+     *         or elem_type is not INT/FLOAT
+     */
+    void set_array(const std::string& key, ArgType_t elem_type, bool check_finite = false);
+
+    /**
+     * @brief Read a list of entries (e.g. paths) from the file named by an argument's value
+     * @param key Argument key of a single-value STR/PATH option (e.g. "--files-from")
+     * @param delimiter '\n' (one entry per line) or '\0' (`find -print0`)
+     * @param visitor If set, receives each entry during parsing and nothing is stored
+     *
+     * Like tar/rsync `--files-from`, for lists too long for argv. The value
+     * "-" reads standard input. The list is read during parse_args(). A
+     * regular file is memory-mapped, and the entries are views into the
+     * mapping. Stdin, pipes and FIFOs are read in large blocks into an arena.
+     * With a visitor the arena keeps one block, so memory stays constant
+     * however long the list. Empty entries are skipped. A visitor may throw
+     * ArgParseException to fail the parse. Entries are read with
+     * get_file_list(); the argument's own value stays the list path.
+     *
+     * @example
+     * ```cpp
+     * parser.add_argument({"--files-from"}, "Read paths from FILE (- = stdin)", ArgParse::PATH);
+     * parser.set_files_from("files_from", '\0');
+     * // find . -print0 | tool --files-from -
+     * for (std::string_view path : parser.get_file_list("files_from")) { ... }
+     * ```
+     *
+     * @throws ArgParseException if key is unknown or not a single-value STR/PATH option
+     */
+    void set_files_from(const std::string& key, char delimiter = '\n',
+                        std::function<void(std::string_view)> visitor = {});
+
+    /**
+     * @brief Run a callback as soon as an optional argument is parsed
+     * @param key Argument key
+     * @param action Receives the option's converted value; returns
+     *        ACTION_STOP to end parsing at once (parse_args() returns 1,
+     *        without reading the rest of argv or checking required arguments)
+     * @param early_exit Handle the flag in the pre-scan (see below)
+     *
+     * Actions run inside the token loop, in command-line order. An
+     * ArgParseException thrown by an action is reported as a parse error.
+     *
+     * With early_exit (BOOL flags only) the action runs in the same pre-scan
+     * as -h/--help: before defaults are filled in or any other token is
+     * parsed, wherever the flag appears before "--".
+     *
+     * @example
+     * ```cpp
+     * parser.add_argument({"--version"}, "Show version", ArgParse::BOOL);
+     * parser.set_action("version", [](const ArgParse::ArgVal_t&) {
+     *     puts("tool 1.2.0");
+     *     return ArgParse::ACTION_STOP;
+     * });
+     * ```
+     *
+     * @throws ArgParseException if key is unknown, names a positional argument,
+     *         or early_exit is set on a non-BOOL argument
+     */
+    void set_action(const std::string& key, std::function<ActionResult_t(const ArgVal_t&)> action, bool early_exit = false);
+
+    /**
+     * @brief Start a named argument group
+     * @param name Section heading in the help output (e.g., "Networking")
+     * @param description Text shown under the heading
+     *
+     * Arguments added until end_group() are listed in their own help
+     * section instead of "Options". Calling begin_group() again with the
+     * same name adds to the existing group. Positional arguments stay in
+     * the "Positional arguments" section.
+     *
+     * @throws ArgParseException if name is empty or names a lazy group
+     */
+    void begin_group(const std::string& name, const std::string& description = "");
+
+    /**
+     * @brief End the current argument group
+     */
+    void end_group();
+
+    /**
+     * @brief Register a group whose arguments are added on first use
+     * @param name Section heading in the help output
+     * @param description Text shown under the heading
+     * @param aliases Options the group defines; meeting one while parsing
+     *        loads the group
+     * @param registrar Adds the group's arguments (and their validators or
+     *        actions) to the parser it is given
+     *
+     * The registrar runs on first use: when parse_args() meets one of
+     * aliases, or when the group's help is shown with print_help_section()
+     * or --help-section=NAME. Until then print_help() lists only the
+     * claimed aliases, and the group's arguments have no parsed values.
+     * Lazy groups may only define optional arguments. If the registrar
+     * throws or adds a positional, the arguments it added are removed and
+     * the group stays unloaded.
+     *
+     * @example
+     * ```cpp
+     * parser.add_lazy_group("Storage", "Object store access", {"--bucket", "--region"},
+     *     [](ArgParse::ArgumentParser& p) {
+     *         p.add_argument({"--bucket"}, "Bucket name", ArgParse::STR);
+     *         p.add_argument({"--region"}, "Region", ArgParse::STR, "us-east-1");
+     *     });
+     * ```
+     *
+     * @throws ArgParseException if the name is taken, aliases is empty, or an
+     *         alias is not an option or is already defined
+     */
+    void add_lazy_group(const std::string& name, const std::string& description,
+                        const std::vector<std::string>& aliases,
+                        std::function<void(ArgumentParser&)> registrar);
+
     /**
      * @brief Parse command-line arguments
      * @param argc Argument count from main()
      * @param argv Argument vector from main()
-     * @return 0 on success, 1 if help was displayed, -1 on error
+     * @return 0 on success, 1 if help was displayed or an action stopped parsing, -1 on error
      * 
      * Parses the provided arguments according to the configured argument
      * definitions. Validates types, checks required arguments, and handles
-     * help display automatically.
+     * help display automatically. A "--" token ends option parsing; all
+     * later tokens are positional.
      */
     int parse_args(int argc, char** argv);
     int parse_args(const std::vector<std::string>& args);
 
+    /**
+     * @brief Parse straight into a result object, e.g. one borrowed from a ResultPool
+     * @param args Arguments including the program name
+     * @param result Receives the parsed values; its previous contents are replaced
+     * @return Same as parse_args(args)
+     *
+     * The storage of result and the parser's own are swapped around the
+     * parse, so map nodes, key strings and vector capacity are reused
+     * across requests instead of reallocated. The parser keeps none of
+     * this parse's values.
+     */
+    int parse_args(const std::vector<std::string>& args, CommandResult_t& result);
+
+    /**
+     * @brief Parse arguments given as a single command string
+     * @param line Arguments without the program name (e.g., "--count 3 'my file.txt'")
+     * @return 0 on success, 1 if help was displayed, -1 on error
+     *
+     * Splits line with split_command_line() and parses the tokens like
+     * parse_args(). Quoting errors are reported as parse errors.
+     */
+    int parse_command_line(std::string_view line);
+
+    /**
+     * @brief Register a sub-command for parse_chain()
+     * @param name Command word (e.g., "filter")
+     * @param parser Parser describing the command's arguments (must outlive this parser)
+     * @throws ArgParseException if the name is empty or already registered
+     */
+    void add_command(const std::string& name, ArgumentParser& parser);
+
+    /**
+     * @brief Parse a pipeline of sub-commands separated by a delimiter token
+     * @param args Full argument list (args[0] is the program name)
+     * @param results Receives one entry per stage, in command-line order.
+     *        Tokens before the first command are parsed by this parser and
+     *        stored first, with an empty command name. Values are moved out
+     *        of the parsers (see take_result()). Option values are skipped by
+     *        nargs, so they may equal a command name or the delimiter.
+     * @param delimiter Token separating stages
+     * @return 0 on success, 1 if help was displayed, -1 on error
+     *
+     * @example
+     * ```cpp
+     * // tool --verbose load --src a + filter --expr x + write --dst y
+     * std::vector<ArgParse::CommandResult_t> stages;
+     * if (parser.parse_chain(args, stages) != 0) return 1;
+     * for (size_t i = 1; i < stages.size(); i++) run(stages[i].command, stages[i].args);
+     * ```
+     */
+    int parse_chain(const std::vector<std::string>& args,
+                    std::vector<CommandResult_t>& results,
+                    const std::string& delimiter = "+");
+
     /**
      * @brief Get parsed optional arguments
      * @return Map of argument keys to parsed values
@@ -194,6 +947,15 @@ public:
      */
     const std::vector<std::string>& get_pos_args() const { return parsed_pos_args_; }
 
+    /**
+     * @brief Move the values of the last parse out of the parser
+     * @return Parsed and raw positional arguments (command is left empty)
+     *
+     * The parser holds no parsed values afterwards, until the next parse.
+     * Use this to keep results past the next parse_args() without copying.
+     */
+    CommandResult_t take_result();
+
     /**
      * @brief Generic template method to get any argument type
      * @tparam T The type to retrieve (bool, int, float, std::string)
@@ -211,59 +973,11 @@ public:
      */
     template<typename T>
     T get(const std::string& key) const {
-        auto it = parsed_args_.find(key);
-        if (it == parsed_args_.end()) {
-            throw std::runtime_error("Argument key '" + key + "' not found. Make sure you defined it with add_argument().");
-        }
-        try {
-            return std::get<T>(it->second.value);
-        } catch (const std::bad_variant_access& e) {
-            // Determine the actual stored type for better error message
-            std::string actual_type;
-            std::visit([&](auto&& arg) {
-                using ArgType = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<ArgType, bool>) {
-                    actual_type = "bool";
-                } else if constexpr (std::is_same_v<ArgType, int>) {
-                    actual_type = "int";
-                } else if constexpr (std::is_same_v<ArgType, float>) {
-                    actual_type = "float";
-                } else if constexpr (std::is_same_v<ArgType, std::string>) {
-                    actual_type = "std::string";
-                } else if constexpr (std::is_same_v<ArgType, std::vector<int>>) {
-                    actual_type = "std::vector<int>";
-                } else if constexpr (std::is_same_v<ArgType, std::vector<float>>) {
-                    actual_type = "std::vector<float>";
-                } else if constexpr (std::is_same_v<ArgType, std::vector<std::string>>) {
-                    actual_type = "std::vector<std::string>";
-                } else {
-                    actual_type = "unknown";
-                }
-            }, it->second.value);
-            
-            std::string requested_type;
-            if constexpr (std::is_same_v<T, bool>) {
-                requested_type = "bool";
-            } else if constexpr (std::is_same_v<T, int>) {
-                requested_type = "int";
-            } else if constexpr (std::is_same_v<T, float>) {
-                requested_type = "float";
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                requested_type = "std::string";
-            } else if constexpr (std::is_same_v<T, std::vector<int>>) {
-                requested_type = "std::vector<int>";
-            } else if constexpr (std::is_same_v<T, std::vector<float>>) {
-                requested_type = "std::vector<float>";
-            } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
-                requested_type = "std::vector<std::string>";
-            } else {
-                requested_type = "unsupported type";
-            }
-            
-            throw std::runtime_error("Type mismatch for argument '" + key + 
-                                   "'. Expected: " + requested_type + 
-                                   ", Got: " + actual_type);
+        const ArgVal_t& v = find_value(key);
+        if (const T* p = std::get_if<T>(&v.value)) {
+            return *p;
         }
+        throw_type_mismatch(key, value_type_name<T>(), v);
     }
 
     /**
@@ -284,6 +998,63 @@ public:
         return get<std::vector<T>>(key);
     }
 
+    /**
+     * @brief Get a read-only view of a STR/PATH/BLOB argument's content
+     * @param key Argument key
+     * @return View over the referenced file for "@path" / "file:path" values,
+     *         or over the value itself otherwise
+     * @throws std::runtime_error if key not found or the value is not a string
+     *
+     * The file is not opened until the view is first read.
+     *
+     * @example
+     * ```cpp
+     * // ./app --template @big_template.txt
+     * FileView tmpl = parser.get_file("template");
+     * std::string_view text = tmpl.view();    // mmap happens here
+     * ```
+     */
+    FileView get_file(const std::string& key) const;
+
+    /**
+     * @brief Get a zero-copy view of a binary array argument
+     * @tparam T Element type (int or float, matching set_array)
+     * @param key Argument key
+     * @return View over the memory-mapped elements
+     * @throws std::runtime_error if key has no mapped array or type mismatch
+     *
+     * @example
+     * ```cpp
+     * parser.set_array("weights", ArgParse::FLOAT);
+     * // ./train --weights model.npy
+     * ArgParse::ArrayView<float> w = parser.get_array<float>("weights");
+     * ```
+     */
+    template<typename T>
+    ArrayView<T> get_array(const std::string& key) const {
+        static_assert(std::is_same_v<T, int> || std::is_same_v<T, float>, "get_array supports int and float");
+        const ArrayData_t& a = find_array(key, std::is_same_v<T, int> ? INT : FLOAT);
+        return ArrayView<T>(a.file, static_cast<const T*>(a.data), a.count);
+    }
+
+    /**
+     * @brief Decode a BLOB argument
+     * @param key Argument key
+     * @return Decoded bytes ("hex:"/"base64:" values) or file bytes ("@path")
+     * @throws std::runtime_error if key not found or not a string value
+     * @throws ArgParseException if a referenced file cannot be read
+     */
+    std::vector<unsigned char> get_blob(const std::string& key) const;
+
+    /**
+     * @brief Entries read for a set_files_from() argument
+     * @return Views into the mapped list or the read buffer; they stay valid
+     *         while the returned view (or a copy) exists. Empty if the option
+     *         was not given or a visitor consumed the entries.
+     * @throws std::runtime_error if the argument was not set up with set_files_from()
+     */
+    ArrayView<std::string_view> get_file_list(const std::string& key) const;
+
     /**
      * @brief Check if an argument was explicitly provided by the user
      * @param key The argument key to check (uses underscore format: "no_cli")
@@ -345,6 +1116,20 @@ public:
         return keys;
     }
 
+    /**
+     * @brief Completion candidates for the last word of a partial command line
+     * @param line Partial line (arguments only, as typed in a console)
+     * @return Sorted candidates: values from `choices` if the previous word is
+     *         an option that has them, otherwise option aliases with the prefix
+     *
+     * @example
+     * ```cpp
+     * parser.complete("--fo");            // {"--force", "--format"}
+     * parser.complete("--format j");      // {"json"}
+     * ```
+     */
+    std::vector<std::string> complete(std::string_view line) const;
+
     /**
      * @brief Print all parsed arguments (for debugging)
      */
@@ -354,6 +1139,214 @@ public:
      * @brief Print help message
      */
     void print_help() const;
+
+    /**
+     * @brief Print help only for arguments matching a search pattern
+     * @param pattern Words to look for; every word must prefix-match an
+     *        alias, key or help-text word of the argument (case-insensitive)
+     *
+     * Used for `--help=<pattern>`. The word index is built on first use and
+     * each argument's help text is rendered once and cached.
+     */
+    void print_help(const std::string& pattern) const;
+
+    /**
+     * @brief Load help text from a file when help is printed
+     * @param path Resource file (see below)
+     *
+     * The file is not opened until print_help() runs, so arguments can be
+     * added with empty help strings and parsers that never print help do
+     * not keep the text in memory. Each line is "key<TAB>help text";
+     * the reserved keys ":description" and ":epilog" supply the program
+     * description and epilog when those are empty. Blank lines and lines
+     * starting with '#' are ignored. Help given to add_argument() takes
+     * precedence. A missing or unreadable file leaves the help empty.
+     *
+     * @example
+     * ```cpp
+     * parser.add_argument({"--port"}, "", ArgParse::INT, "80");
+     * parser.set_help_resource("/usr/share/tool/help.tsv");   // port<TAB>Server port
+     * ```
+     */
+    void set_help_resource(const std::string& path);
+
+    /**
+     * @brief Use help text already in memory (same format as the file)
+     * @param data Resource contents, e.g. a section linked into the binary
+     *        (must outlive this parser)
+     * @param size Length of data in bytes
+     */
+    void set_help_resource(const char* data, size_t size);
+
+    /**
+     * @brief Print the help section of one argument group
+     * @param group Group name; a lazy group is loaded first
+     *
+     * Also available on the command line as --help-section=NAME.
+     *
+     * @throws ArgParseException if no group has this name
+     */
+    void print_help_section(const std::string& group);
+
+    /**
+     * @brief Send help and print_args output to a sink instead of stdout
+     * @param sink Destination (not owned; must outlive its use), or nullptr for fd 1
+     *
+     * The default writes to fd 1 with write(2), bypassing stdio's buffer. If
+     * stdout is a pipe or file, text the program printf'd earlier but has not
+     * flushed appears after the parser's output. Programs that mix the two
+     * should pass a FileSink(stdout), as printf did before sinks existed.
+     *
+     * @example
+     * ```cpp
+     * ArgParse::BufferSink help;
+     * parser.set_output(&help);
+     * parser.print_help();            // help.str() holds the text
+     * ```
+     */
+    void set_output(OutputSink* sink) { out_ = sink; }
+
+    /**
+     * @brief Send parse errors to a sink instead of stderr
+     * @param sink Destination (not owned), or nullptr for fd 2 (written
+     *        with write(2); use FileSink(stderr) to order with stdio)
+     */
+    void set_error_output(OutputSink* sink) { err_ = sink; }
+
+    /// Current output and error sinks (the fd 1 / fd 2 defaults if none set)
+    OutputSink& output() const;
+    OutputSink& error_output() const;
+};
+
+
+/**
+ * @brief Line-oriented command console on top of an ArgumentParser
+ *
+ * Each line is tokenized with shell quoting rules, parsed with the same
+ * parser and, on success, passed to the handler. Token buffers are reused
+ * between lines. Parse errors and help are printed and the loop goes on.
+ *
+ * @example
+ * ```cpp
+ * ArgParse::ArgumentRepl repl(parser, [](const ArgParse::ArgumentParser& p) {
+ *     if (p.get<bool>("quit")) return 1;      // non-zero ends run()
+ *     serve(p.get<std::string>("cmd"));
+ *     return 0;
+ * });
+ * repl.run(stdin);
+ * ```
+ */
+class ArgumentRepl {
+public:
+    /// Called with the parser after each successfully parsed line; non-zero stops run()
+    using Handler = std::function<int(const ArgumentParser&)>;
+
+    /**
+     * @param parser Parser holding the command spec (must outlive the REPL)
+     * @param handler Callback for parsed lines
+     * @param prompt Prompt written before each line read by run()
+     */
+    ArgumentRepl(ArgumentParser& parser, Handler handler, const std::string& prompt = "> ");
+
+    /**
+     * @brief Tokenize, parse and dispatch one line
+     * @return Handler result, 0 for blank lines, or the non-zero parse_args() result
+     */
+    int execute(std::string_view line);
+
+    /**
+     * @brief Read and execute lines until end of input or a non-zero handler result
+     * @param in Input stream (prompts go to the parser's output() when in is a terminal)
+     * @return Handler result that ended the loop, or 0 at end of input
+     */
+    int run(FILE* in);
+
+    /**
+     * @brief Completion candidates for a partial line (see ArgumentParser::complete)
+     */
+    std::vector<std::string> complete(std::string_view line) const { return parser_.complete(line); }
+
+private:
+    ArgumentParser& parser_;            ///< Parser for every line
+    Handler handler_;                   ///< Dispatch target
+    std::string prompt_;                ///< Interactive prompt
+    CommandTokenizer tokenizer_;        ///< Reused tokenizer state
+    std::vector<std::string> tokens_;   ///< Reused token buffer (program name + arguments)
+    bool dispatched_ = false;           ///< Whether the last execute() reached the handler
+};
+
+
+/**
+ * @brief Push-style parser for commands arriving as a byte stream
+ *
+ * Bytes are fed in whatever chunks the pipe or socket delivers. They are
+ * tokenized as they arrive, with quotes and escapes allowed to cross chunk
+ * boundaries, so only the tokens of the command in progress are held. An
+ * unquoted newline ends a command: it is parsed at once and, on success,
+ * passed to the handler. Parse errors go to the parser's error sink and
+ * the stream goes on.
+ *
+ * @example
+ * ```cpp
+ * ArgParse::StreamParser stream(parser, [](const ArgParse::ArgumentParser& p) {
+ *     submit(p.get<std::string>("job"));
+ *     return 0;                   // non-zero ends the stream
+ * });
+ * char buf[4096];
+ * ssize_t n;
+ * while ((n = read(sock, buf, sizeof(buf))) > 0) {
+ *     if (stream.feed(std::string_view(buf, n)) != 0) break;
+ * }
+ * stream.finish();                // last command, if not newline-terminated
+ * ```
+ */
+class StreamParser {
+public:
+    /// Called with the parser after each successfully parsed command; non-zero ends the stream
+    using Handler = std::function<int(const ArgumentParser&)>;
+
+    /**
+     * @param parser Parser holding the command spec (must outlive the stream)
+     * @param handler Callback for parsed commands
+     */
+    StreamParser(ArgumentParser& parser, Handler handler);
+
+    /**
+     * @brief Consume a chunk, parsing every command it completes
+     * @return 0, or the non-zero handler result that ended the stream (the
+     *         rest of the chunk and later input are then ignored)
+     */
+    int feed(std::string_view chunk);
+
+    /**
+     * @brief End of input: parse a final command that has no newline
+     * @return 0, the handler result, or -1 on an unterminated quote or escape
+     */
+    int finish();
+
+    /**
+     * @brief Read a file descriptor (pipe, socket, file) to end of input
+     * @return Same as feed()/finish(), or -1 if read(2) fails
+     */
+    int run(int fd);
+
+    /// Drop the command in progress and accept input again after a handler stop
+    void reset();
+
+    size_t commands() const { return commands_; }   ///< Commands parsed so far
+    size_t errors() const { return errors_; }       ///< Commands that failed to parse
+
+private:
+    ArgumentParser& parser_;            ///< Parser for every command
+    Handler handler_;                   ///< Dispatch target
+    CommandTokenizer tokenizer_;        ///< Carries partial tokens across chunks
+    std::vector<std::string> tokens_;   ///< Command in progress (program name + arguments)
+    size_t commands_ = 0;
+    size_t errors_ = 0;
+    int stopped_ = 0;                   ///< Handler result that ended the stream
+
+    /// Parse tokens_ and dispatch; returns the handler result (0 if not dispatched)
+    int dispatch();
 };
 
 
@@ -385,3 +1378,19 @@ public:
 };
 
 } // namespace ArgParse
+
+#ifdef ARGPARSE_HEADER_ONLY
+    // `make install` copies the sources next to the header as argparse/impl/.
+    // Builds against the source tree define ARGPARSE_SOURCE_TREE to use ../src/.
+    #ifdef ARGPARSE_SOURCE_TREE
+        #include "../src/argparse.cpp"
+        #include "../src/tokenizer.cpp"
+        #include "../src/repl.cpp"
+        #include "../src/stream.cpp"
+    #else
+        #include "argparse/impl/argparse.cpp"
+        #include "argparse/impl/tokenizer.cpp"
+        #include "argparse/impl/repl.cpp"
+        #include "argparse/impl/stream.cpp"
+    #endif
+#endif
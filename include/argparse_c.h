@@ -0,0 +1,170 @@
+/**
+ * @file argparse_c.h
+ * @brief C interface to the ArgParse library
+ *
+ * A stable C ABI over ArgumentParser for C programs and FFI bindings,
+ * exported by build/lib/libargparse.so (and the static library).
+ *
+ * A spec (argparse_spec) describes the arguments. Each argument added
+ * to it gets a slot number. Parsing produces a result (argparse_result)
+ * that owns the parsed values. Accessors read a value by slot. Strings
+ * and numeric lists are returned as pointer + length views into the
+ * result's own storage. Nothing is copied per call, and the views stay
+ * valid until the result is freed. No C++ exception crosses this
+ * interface.
+ *
+ * @example
+ * ```c
+ * argparse_spec* spec = argparse_spec_new("tool", "Example tool");
+ * const char* count_aliases[] = {"-n", "--count"};
+ * int count = argparse_spec_add(spec, count_aliases, 2, "Repeat count", ARGPARSE_INT,
+ *                               "1", 0, NULL, 0, NULL);
+ * const char* file_aliases[] = {"file"};
+ * int file = argparse_spec_add(spec, file_aliases, 1, "Input file", ARGPARSE_STR,
+ *                              NULL, 1, NULL, 0, NULL);
+ *
+ * argparse_result* res = NULL;
+ * if (argparse_parse(spec, argc, (const char* const*)argv, &res) != 0) {
+ *     argparse_spec_free(spec);
+ *     return 1;
+ * }
+ * int n = 0;
+ * const char* path; size_t path_len;
+ * argparse_get_int(res, count, &n);
+ * argparse_get_str(res, file, &path, &path_len);
+ * argparse_result_free(res);
+ * argparse_spec_free(spec);
+ * ```
+ */
+
+#ifndef ARGPARSE_C_H
+#define ARGPARSE_C_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Version of this interface; bumped only on incompatible changes
+#define ARGPARSE_C_API_VERSION 1
+
+/// Argument types (same values as ArgParse::ArgType_t)
+typedef enum {
+    ARGPARSE_BOOL  = 1,
+    ARGPARSE_INT   = 2,
+    ARGPARSE_FLOAT = 3,
+    ARGPARSE_STR   = 4,
+    ARGPARSE_PATH  = 5,
+    ARGPARSE_BLOB  = 6
+} argparse_type;
+
+/// Accessor status codes
+#define ARGPARSE_OK          0      ///< Value returned
+#define ARGPARSE_ERR_SLOT   -1      ///< No such slot, or the argument has no value
+#define ARGPARSE_ERR_TYPE   -2      ///< Value has a different type (or is/isn't a list)
+#define ARGPARSE_ERR_RANGE  -3      ///< List index out of range
+
+typedef struct argparse_spec argparse_spec;         ///< Argument definitions (opaque)
+typedef struct argparse_result argparse_result;     ///< Values of one parse (opaque)
+
+/**
+ * @brief Interface version of the loaded library (ARGPARSE_C_API_VERSION)
+ */
+int argparse_api_version(void);
+
+/**
+ * @brief Create an empty spec
+ * @param prog Program name (NULL = taken from argv[0])
+ * @param description Program description for help (may be NULL)
+ * @return New spec, or NULL if out of memory
+ */
+argparse_spec* argparse_spec_new(const char* prog, const char* description);
+
+/**
+ * @brief Free a spec (results created from it stay valid)
+ */
+void argparse_spec_free(argparse_spec* spec);
+
+/**
+ * @brief Add an argument
+ * @param aliases Names, e.g. {"-n", "--count"}, or {"file"} for a positional
+ * @param n_aliases Number of aliases
+ * @param help Help text (may be NULL)
+ * @param type Value type (ARGPARSE_BOOL to ARGPARSE_BLOB)
+ * @param default_value Default as a string (NULL = none)
+ * @param required Non-zero if the argument must be given
+ * @param choices Allowed values (may be NULL)
+ * @param n_choices Number of choices
+ * @param nargs NULL, "?", "*", "+" or a count
+ * @return Slot number (>= 0), or -1 on error (see argparse_spec_error)
+ */
+int argparse_spec_add(argparse_spec* spec, const char* const* aliases, size_t n_aliases,
+                      const char* help, argparse_type type, const char* default_value, int required,
+                      const char* const* choices, size_t n_choices, const char* nargs);
+
+/**
+ * @brief Slot number of an argument by key (e.g. "count" for "--count")
+ * @return Slot number, or -1 if no argument has this key
+ */
+int argparse_spec_slot(const argparse_spec* spec, const char* key);
+
+/**
+ * @brief Message of the last failed call on this spec ("" if none)
+ *
+ * The pointer stays valid until the next call on the spec.
+ */
+const char* argparse_spec_error(const argparse_spec* spec);
+
+/**
+ * @brief Parse a command line
+ * @param argc Number of entries in argv (argv[0] is the program name)
+ * @param argv Arguments
+ * @param result Receives the new result on success (left NULL otherwise)
+ * @return 0 on success, 1 if help was shown or parsing was stopped by an
+ *         action, -1 on error (message in argparse_spec_error; nothing
+ *         is written to stderr)
+ */
+int argparse_parse(argparse_spec* spec, int argc, const char* const* argv, argparse_result** result);
+
+/**
+ * @brief Free a result and every view returned from it
+ */
+void argparse_result_free(argparse_result* result);
+
+/** @name Single values
+ *  Return ARGPARSE_OK and store the value, or an ARGPARSE_ERR_* code.
+ *  @{
+ */
+int argparse_get_bool(const argparse_result* result, int slot, int* value);
+int argparse_get_int(const argparse_result* result, int slot, int* value);
+int argparse_get_float(const argparse_result* result, int slot, float* value);
+/// STR, PATH and BLOB values; data is NUL-terminated
+int argparse_get_str(const argparse_result* result, int slot, const char** data, size_t* len);
+/** @} */
+
+/** @name Lists (nargs)
+ *  @{
+ */
+/// Number of values in a list argument (0 if the slot holds no list)
+size_t argparse_get_count(const argparse_result* result, int slot);
+/// Contiguous view of an INT list
+int argparse_get_int_list(const argparse_result* result, int slot, const int** data, size_t* count);
+/// Contiguous view of a FLOAT list
+int argparse_get_float_list(const argparse_result* result, int slot, const float** data, size_t* count);
+/// One element of a STR/PATH/BLOB list; data is NUL-terminated
+int argparse_get_str_at(const argparse_result* result, int slot, size_t index, const char** data, size_t* len);
+/** @} */
+
+/**
+ * @brief Raw positional arguments
+ * @return Number of positional tokens; element i is read with argparse_get_pos_at()
+ */
+size_t argparse_get_pos_count(const argparse_result* result);
+int argparse_get_pos_at(const argparse_result* result, size_t index, const char** data, size_t* len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARGPARSE_C_H
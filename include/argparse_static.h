@@ -0,0 +1,438 @@
+/**
+ * @file argparse_static.h
+ * @brief Heap-free, fixed-capacity argument parser
+ *
+ * StaticParser is a small companion to ArgumentParser for processes that
+ * must not allocate after initialization (real-time threads, sandboxes).
+ * All state lives inside the object, sized by template parameters, so a
+ * parser declared as a static or global uses no heap at all:
+ *
+ * - Capacity limits are compile-time template arguments
+ * - STR/PATH values are pointers into argv (argv must outlive the parser)
+ * - Errors are formatted into a fixed buffer and written to stderr
+ * - No exceptions are thrown; bad calls return -1 or a zero value
+ *
+ * Supported: optional and positional BOOL/INT/FLOAT/STR/PATH arguments,
+ * defaults, required arguments, choices, numeric ranges, "--" and -h/--help.
+ * INT/FLOAT values are checked with is_int_token()/is_float_token(), so both
+ * parsers accept the same numbers.
+ * Not supported: nargs lists, BLOB, actions and the other ArgumentParser
+ * extensions.
+ *
+ * @example
+ * ```cpp
+ * static ArgParse::StaticParser<8> parser("agent", "Real-time agent");
+ *
+ * int main(int argc, char** argv) {
+ *     parser.add_argument("--rate", "-r", "Sample rate (Hz)", ArgParse::INT, "100");
+ *     parser.add_argument("--mode", nullptr, "Run mode", ArgParse::STR, "fast");
+ *     parser.add_argument("device", nullptr, "Device path", ArgParse::PATH, nullptr, true);
+ *     static const char* const modes[] = {"fast", "safe"};
+ *     parser.set_choices("mode", modes, 2);
+ *     if (parser.parse_args(argc, argv) != 0) return 1;
+ *     int rate = parser.get<int>("rate");
+ *     const char* device = parser.get<const char*>("device");
+ * }
+ * ```
+ */
+
+#pragma once
+
+#include "argparse.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdarg>
+#include <type_traits>
+
+namespace ArgParse {
+
+/**
+ * @brief Fixed-capacity parser that never allocates
+ * @tparam MaxArgs Maximum number of arguments (excluding -h/--help)
+ * @tparam MaxError Size of the error message buffer
+ */
+template<size_t MaxArgs, size_t MaxError = ARGPARSE_MAX_STRLEN>
+class StaticParser {
+public:
+    /**
+     * @param prog_name Program name (taken from argv[0] if null)
+     * @param description Program description for help (may be null)
+     *
+     * Strings passed to the parser are not copied and must stay valid.
+     */
+    explicit StaticParser(const char* prog_name = nullptr, const char* description = nullptr):
+        prog_name_(prog_name), description_(description)
+    {
+        error_[0] = '\0';
+    }
+
+    /**
+     * @brief Add an argument
+     * @param name "--long" / "-s" for an option, or a bare name for a positional
+     * @param alt Second alias (e.g. "-n"), or null
+     * @param help Help text (may be null)
+     * @param type BOOL, INT, FLOAT, STR or PATH
+     * @param defaultval Default value (null = none)
+     * @param required Whether the argument must be given
+     * @return Slot number, or -1 if full, invalid, or required with a default
+     */
+    int add_argument(const char* name, const char* alt, const char* help, ArgType_t type = BOOL,
+                     const char* defaultval = nullptr, bool required = false) {
+        if (count_ >= MaxArgs || !name || !*name || type == UNK || type == BLOB || (required && defaultval)) {
+            return -1;
+        }
+        Slot& s = slots_[count_];
+        s = Slot();
+        s.name = name;
+        s.alt = alt;
+        s.help = help;
+        s.type = type;
+        s.defaultval = defaultval;
+        s.required = required;
+        s.positional = name[0] != '-';
+        if (type == BOOL && s.positional) {
+            return -1;
+        }
+        return (int)count_++;
+    }
+
+    /**
+     * @brief Restrict a STR/PATH argument to a set of values
+     * @return 0, or -1 if key is unknown
+     */
+    int set_choices(const char* key, const char* const* choices, size_t n) {
+        Slot* s = find(key);
+        if (!s) return -1;
+        s->choices = choices;
+        s->num_choices = n;
+        return 0;
+    }
+
+    /**
+     * @brief Bound an INT/FLOAT argument to [min_val, max_val]
+     * @return 0, or -1 if key is unknown or not numeric
+     */
+    int set_range(const char* key, double min_val, double max_val) {
+        Slot* s = find(key);
+        if (!s || (s->type != INT && s->type != FLOAT) || min_val > max_val) return -1;
+        s->has_range = true;
+        s->min_val = min_val;
+        s->max_val = max_val;
+        return 0;
+    }
+
+    /**
+     * @brief Parse command-line arguments
+     * @return 0 on success, 1 if help was displayed, -1 on error
+     *
+     * On error the message is available from error() and is also written
+     * to stderr, like ArgumentParser::parse_args().
+     */
+    int parse_args(int argc, const char* const* argv) {
+        error_[0] = '\0';
+        if (!prog_name_ && argc > 0) {
+            prog_name_ = argv[0];
+        }
+        for (size_t k = 0; k < count_; k++) {
+            slots_[k].given = false;
+            if (slots_[k].type == BOOL) {
+                slots_[k].value.b = false;
+            } else if (slots_[k].defaultval && !store(slots_[k], slots_[k].defaultval, slots_[k].name)) {
+                return fail_parse();
+            } else if (!slots_[k].defaultval) {
+                slots_[k].value = Value();
+            }
+        }
+
+        // Help first, as in ArgumentParser
+        for (int i = 1; i < argc && std::strcmp(argv[i], "--") != 0; i++) {
+            if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+                print_help();
+                return 1;
+            }
+        }
+
+        size_t next_positional = 0;
+        bool options_done = false;
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            if (!options_done && std::strcmp(arg, "--") == 0) {
+                options_done = true;
+                continue;
+            }
+            if (!options_done && arg[0] == '-' && arg[1] != '\0' && !is_negative_number(arg)) {
+                Slot* s = find_alias(arg);
+                if (!s) {
+                    set_error("Unknown argument: %s", arg);
+                    return fail_parse();
+                }
+                if (s->type == BOOL) {
+                    s->value.b = true;
+                } else {
+                    if (i + 1 >= argc) {
+                        set_error("Missing value for argument: %s", arg);
+                        return fail_parse();
+                    }
+                    if (!store(*s, argv[++i], arg)) {
+                        return fail_parse();
+                    }
+                }
+                s->given = true;
+                continue;
+            }
+            Slot* s = nth_positional(next_positional++);
+            if (!s) {
+                set_error("Unexpected positional argument: %s", arg);
+                return fail_parse();
+            }
+            if (!store(*s, arg, s->name)) {
+                return fail_parse();
+            }
+            s->given = true;
+        }
+
+        for (size_t k = 0; k < count_; k++) {
+            if (slots_[k].required && !slots_[k].given) {
+                set_error(slots_[k].positional ? "Missing required positional argument: %s"
+                                               : "Required argument missing: %s", slots_[k].name);
+                return fail_parse();
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get a parsed value by key ("rate" for "--rate") or slot name
+     * @tparam T bool, int, float or const char* (STR/PATH)
+     * @return The value, or a zero value if key is unknown or T does not match
+     */
+    template<typename T>
+    T get(const char* key) const {
+        const Slot* s = find(key);
+        if (!s) return T();
+        if constexpr (std::is_same_v<T, bool>) {
+            return s->type == BOOL ? s->value.b : false;
+        } else if constexpr (std::is_same_v<T, int>) {
+            return s->type == INT ? s->value.i : 0;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return s->type == FLOAT ? s->value.f : 0.0f;
+        } else {
+            static_assert(std::is_same_v<T, const char*>, "StaticParser::get supports bool, int, float and const char*");
+            return (s->type == STR || s->type == PATH) ? s->value.s : nullptr;
+        }
+    }
+
+    /// Whether the argument was given on the command line (defaults do not count)
+    bool has_argument(const char* key) const {
+        const Slot* s = find(key);
+        return s && s->given;
+    }
+
+    /// Message of the last parse error ("" if none)
+    const char* error() const { return error_; }
+
+    /// Number of defined arguments
+    size_t size() const { return count_; }
+
+    /**
+     * @brief Print usage and argument help
+     * @param out Stream to write to (stdout by default)
+     *
+     * Give the stream a static buffer with setvbuf() if its first use must
+     * not allocate.
+     */
+    void print_help(FILE* out = stdout) const {
+        std::fprintf(out, "Usage: %s [options] [args]\n", prog_name_ ? prog_name_ : "");
+        if (description_ && *description_) {
+            std::fprintf(out, "Description: %s\n", description_);
+        }
+        std::fprintf(out, "\nOptions:\n  -h, --help\n    Show this help message and exit\n");
+        for (size_t k = 0; k < count_; k++) {
+            if (!slots_[k].positional) print_entry(out, slots_[k]);
+        }
+        bool header = false;
+        for (size_t k = 0; k < count_; k++) {
+            if (!slots_[k].positional) continue;
+            if (!header) {
+                std::fprintf(out, "\nPositional arguments:\n");
+                header = true;
+            }
+            print_entry(out, slots_[k]);
+        }
+        std::fprintf(out, "\n");
+    }
+
+private:
+    union Value {
+        bool b;
+        int i;
+        float f;
+        const char* s;
+        Value(): s(nullptr) {}
+    };
+
+    struct Slot {
+        const char* name = nullptr;
+        const char* alt = nullptr;
+        const char* help = nullptr;
+        const char* defaultval = nullptr;
+        const char* const* choices = nullptr;
+        size_t num_choices = 0;
+        ArgType_t type = UNK;
+        bool required = false;
+        bool positional = false;
+        bool given = false;
+        bool has_range = false;
+        double min_val = 0;
+        double max_val = 0;
+        Value value;
+    };
+
+    const char* prog_name_;
+    const char* description_;
+    Slot slots_[MaxArgs];
+    size_t count_ = 0;
+    char error_[MaxError];
+
+    // Same rule as alias2key(): "--dry-run" matches key "dry_run"
+    static bool key_matches(const char* alias, const char* key) {
+        if (!alias) return false;
+        while (*alias == '-') alias++;
+        for (; *alias && *key; alias++, key++) {
+            char a = *alias == '-' ? '_' : *alias;
+            char k = *key == '-' ? '_' : *key;
+            if (a != k) return false;
+        }
+        return *alias == '\0' && *key == '\0';
+    }
+
+    static bool is_negative_number(const char* s) {
+        return s[0] == '-' && is_float_token(s);
+    }
+
+    const Slot* find(const char* key) const {
+        if (!key) return nullptr;
+        for (size_t k = 0; k < count_; k++) {
+            if (key_matches(slots_[k].name, key) || key_matches(slots_[k].alt, key)) {
+                return &slots_[k];
+            }
+        }
+        return nullptr;
+    }
+    Slot* find(const char* key) {
+        return const_cast<Slot*>(static_cast<const StaticParser*>(this)->find(key));
+    }
+
+    Slot* find_alias(const char* alias) {
+        for (size_t k = 0; k < count_; k++) {
+            Slot& s = slots_[k];
+            if (!s.positional && (std::strcmp(s.name, alias) == 0 || (s.alt && std::strcmp(s.alt, alias) == 0))) {
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    Slot* nth_positional(size_t n) {
+        for (size_t k = 0; k < count_; k++) {
+            if (slots_[k].positional && n-- == 0) {
+                return &slots_[k];
+            }
+        }
+        return nullptr;
+    }
+
+    void set_error(const char* fmt, ...) {
+        va_list ap;
+        va_start(ap, fmt);
+        std::vsnprintf(error_, MaxError, fmt, ap);
+        va_end(ap);
+    }
+
+    int fail_parse() {
+        std::fputs("Argument parsing error: ", stderr);
+        std::fputs(error_, stderr);
+        std::fputc('\n', stderr);
+        return -1;
+    }
+
+    // Convert and validate raw into s.value; false (with error_ set) on failure
+    bool store(Slot& s, const char* raw, const char* name) {
+        char* end = nullptr;
+        double number = 0;
+        errno = 0;
+        switch (s.type) {
+            case INT: {
+                // Same token rules as ArgumentParser; strtol alone would take " 5" and "+5"
+                long v = is_int_token(raw) ? std::strtol(raw, &end, 10) : 0;
+                if (end == nullptr || errno == ERANGE || v < INT_MIN || v > INT_MAX) {
+                    set_error("Invalid integer value for %s: %s", name, raw);
+                    return false;
+                }
+                s.value.i = (int)v;
+                number = (double)v;
+                break;
+            }
+            case FLOAT: {
+                // No exponent, inf or nan, as in ArgumentParser
+                float v = is_float_token(raw) ? std::strtof(raw, &end) : 0;
+                if (end == nullptr) {
+                    set_error("Invalid float value for %s: %s", name, raw);
+                    return false;
+                }
+                if (errno == ERANGE || !std::isfinite(v)) {
+                    set_error("Value out of range for %s: %s", name, raw);
+                    return false;
+                }
+                s.value.f = v;
+                number = v;
+                break;
+            }
+            case BOOL:
+                s.value.b = std::strcmp(raw, "true") == 0 || std::strcmp(raw, "1") == 0;
+                return true;
+            default:
+                s.value.s = raw;
+                break;
+        }
+        if (s.has_range && (number < s.min_val || number > s.max_val)) {
+            set_error("Value out of range for %s: %s (expected %g <= value <= %g)", name, raw, s.min_val, s.max_val);
+            return false;
+        }
+        if (s.num_choices > 0) {
+            for (size_t c = 0; c < s.num_choices; c++) {
+                if (std::strcmp(s.choices[c], raw) == 0) return true;
+            }
+            set_error("Invalid choice for %s: '%s'", name, raw);
+            return false;
+        }
+        return true;
+    }
+
+    static void print_entry(FILE* out, const Slot& s) {
+        static const char* const metas[] = {"VALUE", "", "N", "F", "STR", "PATH", "BLOB"};
+        std::fprintf(out, "  %s", s.name);
+        if (!s.positional && s.type != BOOL) std::fprintf(out, " %s", metas[s.type]);
+        if (s.alt) {
+            std::fprintf(out, ", %s", s.alt);
+            if (s.type != BOOL) std::fprintf(out, " %s", metas[s.type]);
+        }
+        std::fprintf(out, "\n    %s\n", s.help ? s.help : "");
+        if (s.num_choices > 0) {
+            std::fprintf(out, "    choices: {");
+            for (size_t c = 0; c < s.num_choices; c++) {
+                std::fprintf(out, "'%s'%s", s.choices[c], c + 1 < s.num_choices ? ", " : "");
+            }
+            std::fprintf(out, "}\n");
+        }
+        if (s.has_range) {
+            std::fprintf(out, "    range: [%g, %g]\n", s.min_val, s.max_val);
+        }
+    }
+};
+
+} // namespace ArgParse
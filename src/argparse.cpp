@@ -1,19 +1,117 @@
 #include "argparse.h"
-#include <iostream>
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
-#include <iostream>
+#include <cstring>
 #include <stdexcept>
 #include <algorithm>
 #include <set>
+#include <cmath>
+#include <type_traits>
+#include <regex>
+#include <thread>
+#include <atomic>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <limits>
+#include <cstdint>
+#include <sys/stat.h>
+#include <unistd.h>
 
-using namespace ArgParse;
+namespace ArgParse {
+
+////////////////////////////////////////////////////////////////////////////////
+// Parser state (kept out of argparse.h)
+
+/**
+ * @brief Internal structure representing a command-line argument
+ */
+struct Argument_t {
+    std::vector<std::string> aliases;   // Argument aliases (e.g., "-v", "--verbose")
+    ArgType_t type      = UNK;          // Argument type
+    std::string key     = "";           // Internal key name
+    std::string help    = "";           // Help text
+    bool required       = false;        // Whether argument is required
+    bool is_positional  = false;        // Whether this is a positional argument
+    ArgVal_t defaultval = {UNK, false};    // Default value (initialized to UNK type with false)
+    std::vector<std::string> choices;   // Allowed values (empty = any value allowed)
+    std::string metavar = "";           // Display name for help (empty = auto-generate)
+    std::string nargs = "";             // Number of arguments: "", "?", "*", "+", or number
+    bool has_min        = false;        // Whether a lower bound is enforced (INT/FLOAT)
+    bool has_max        = false;        // Whether an upper bound is enforced (INT/FLOAT)
+    double min_val      = 0;            // Lower bound (inclusive)
+    double max_val      = 0;            // Upper bound (inclusive)
+    double step         = 0;            // Values must be min + k*step (0 = any value)
+    std::function<bool(const std::string&)> validator;  // Custom predicate on the raw value (empty = none)
+    std::string validator_msg = "";     // Error text used when validator rejects a value
+    std::shared_ptr<const Pattern_t> pattern;   // Regex every STR value must fully match (null = none)
+    int path_checks     = 0;            // PathCheck_t flags for PATH arguments (0 = no checks)
+    bool glob           = false;        // Expand shell-style wildcards in values
+    size_t glob_max     = 0;            // Maximum matches per pattern (0 = unlimited)
+    ArgType_t array_type = UNK;         // Element type (INT/FLOAT) if the value names a binary array file
+    bool array_check_finite = false;    // Reject NaN/Inf elements in FLOAT arrays
+    bool files_from     = false;        // The value names a list file ("-" = stdin), see set_files_from()
+    char files_from_delim = '\n';       // Entry delimiter of the list ('\n' or '\0')
+    std::function<void(std::string_view)> files_from_visitor;  // Receives entries instead of storing them (empty = store)
+    std::function<ActionResult_t(const ArgVal_t&)> action;  // Run when the option is encountered (empty = none)
+    bool early_exit     = false;        // Run action in the pre-scan, like -h/--help
+    std::string group   = "";           // Help section set by begin_group() ("" = Options)
+};
+
+/// Help text kept outside the argument table (see set_help_resource)
+struct HelpResource_t {
+    std::shared_ptr<MappedFile> file;                   ///< Mapped on first use (null for in-memory text)
+    std::string_view data;                              ///< Resource contents once available
+    bool indexed = false;                               ///< text has been built
+    std::map<std::string, std::string_view> text;       ///< Argument key -> help text in data
+};
+
+/// Named help section; a lazy group registers its arguments on first use
+struct Group_t {
+    std::string name;
+    std::string description;
+    std::vector<std::string> aliases;                   ///< Options claimed by a lazy group
+    std::function<void(ArgumentParser&)> registrar;     ///< Adds the group's arguments (empty once loaded)
+};
+
+struct ArgumentParser::Impl {
+    std::string prog_name_;     ///< Program name
+    std::string description_;   ///< Program description
+    std::string epilog_;        ///< Additional help text
+
+    std::vector<Argument_t>         arg_list_;          ///< List of defined arguments
+    std::vector<size_t>             pos_arg_list_;      ///< Indices of positional arguments in arg_list_ (for ordering)
+    std::vector<std::string>        args_;              ///< Raw command-line arguments
+    std::map<std::string, size_t>   alias_index_;       ///< Optional-argument aliases -> index in arg_list_
+    std::map<std::string, ArgumentParser*> commands_;   ///< Chainable sub-commands by name
+
+    std::vector<std::string> help_entries_;                 ///< Rendered help per argument (filled on demand)
+    std::map<std::string, std::vector<size_t>> help_index_; ///< Help word -> argument indices (built on first search)
+    std::shared_ptr<HelpResource_t> help_resource_;         ///< External help text (null = none)
+
+    size_t parallel_min_ = 65536;       ///< nargs lists this long are converted in parallel (0 = never)
+    unsigned parallel_threads_ = 0;     ///< Conversion threads (0 = hardware concurrency)
+
+    std::vector<Group_t>            groups_;            ///< Groups in declaration order
+    std::map<std::string, size_t>   lazy_alias_index_;  ///< Aliases of unloaded lazy groups -> index in groups_
+    std::string                     current_group_;     ///< Group of arguments added now (see begin_group)
+
+    std::vector<char> provided_;        ///< Per argument: given or defaulted in the current parse
+
+    std::map<std::string, ArrayData_t> arrays_;    ///< Mapped arrays by argument key
+    std::map<std::string, ArrayView<std::string_view>> file_lists_;    ///< Entries read for set_files_from() arguments
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 // Helpers
 
+namespace detail {
+
 // Check if a string is a negative number (starts with - followed by digits)
-bool is_negative_number(const std::string& str) {
+inline bool is_negative_number(const std::string& str) {
     if (str.length() < 2 || str[0] != '-') {
         return false;
     }
@@ -29,7 +127,7 @@ bool is_negative_number(const std::string& str) {
 }
 
 // Check if value is in allowed choices
-bool is_valid_choice(const std::string& value, const std::vector<std::string>& choices) {
+inline bool is_valid_choice(const std::string& value, const std::vector<std::string>& choices) {
     if (choices.empty()) {
         return true;  // No choices restriction
     }
@@ -38,7 +136,7 @@ bool is_valid_choice(const std::string& value, const std::vector<std::string>& c
 }
 
 // Check if nargs format is valid
-bool is_valid_nargs(const std::string& nargs) {
+inline bool is_valid_nargs(const std::string& nargs) {
     if (nargs.empty() || nargs == "?" || nargs == "*" || nargs == "+") {
         return true;
     }
@@ -52,98 +150,192 @@ bool is_valid_nargs(const std::string& nargs) {
     return true;
 }
 
-// Get expected argument count for nargs
-int get_nargs_count(const std::string& nargs, bool& is_variable) {
-    is_variable = false;
-    
+// Token count bounds of an nargs spec: "?" 0-1, "*" 0+, "+" 1+, N exactly N
+inline void nargs_bounds(const std::string& nargs, size_t& lo, size_t& hi) {
     if (nargs.empty()) {
-        return 1;  // Default: exactly 1 argument
+        lo = hi = 1;
     } else if (nargs == "?") {
-        is_variable = true;
-        return 1;  // 0 or 1 argument
+        lo = 0; hi = 1;
     } else if (nargs == "*") {
-        is_variable = true;
-        return 0;  // 0 or more arguments
+        lo = 0; hi = SIZE_MAX;
     } else if (nargs == "+") {
-        is_variable = true;
-        return 1;  // 1 or more arguments
+        lo = 1; hi = SIZE_MAX;
     } else {
-        // Should be a number
-        return std::stoi(nargs);
+        lo = hi = (size_t)std::stoul(nargs);
     }
 }
 
-// Convert alias to key
-std::string alias2key(const std::string& alias) {
-    if(alias.find("--") == 0) {
-        return alias.substr(2);
+// Threads to convert a list of count values with (set_parallel_conversion)
+inline unsigned conversion_threads(size_t count, size_t min_values, unsigned threads) {
+    if (min_values == 0 || count < min_values) {
+        return 1;
+    }
+    return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Run task(0) .. task(n - 1) on worker threads. A task whose thread cannot be
+// created (e.g. under a thread limit or seccomp) runs on the calling thread.
+// Every started thread is joined before returning or rethrowing.
+template<typename Task>
+inline void run_parallel(size_t n, const Task& task) {
+    std::vector<std::thread> workers;
+    workers.reserve(n);
+    std::exception_ptr error;
+    for (size_t t = 0; t < n && !error; t++) {
+        try {
+            workers.emplace_back(task, t);
+        } catch (...) {
+            try {
+                task(t);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
     }
-    else if(alias.find("-") == 0) {
-        return alias.substr(1);
+    for (auto& w : workers) {
+        w.join();
     }
-    else {
-        return alias;
+    if (error) {
+        std::rethrow_exception(error);
     }
 }
 
-// Parse multiple values for nargs
-std::vector<std::string> parse_nargs_values(
+// Whether args[index] can be a value of a variable-length nargs list
+inline bool is_list_value(const std::vector<std::string>& args, size_t index) {
+    return index < args.size() && (args[index][0] != '-' || is_negative_number(args[index]));
+}
+
+// Values of an nargs option as a view into args (no copies). The span is
+// found first, so callers can size their output exactly once.
+inline ArrayView<std::string> parse_nargs_values(
     const std::vector<std::string>& args,
     size_t& current_index,
     const std::string& nargs,
     const std::string& arg_name) {
     
-    std::vector<std::string> values;
+    size_t count = 0;
     
     if (nargs.empty() || nargs == "1") {
         // Default case: exactly one argument
         if (current_index >= args.size()) {
             throw ArgParseException("Missing value for argument: " + arg_name);
         }
-        values.push_back(args[current_index]);
-        current_index++;
+        count = 1;
     } else if (nargs == "?") {
         // Optional: 0 or 1 argument  
-        if (current_index < args.size() && (args[current_index][0] != '-' || is_negative_number(args[current_index]))) {
-            values.push_back(args[current_index]);
-            current_index++;
-        }
-    } else if (nargs == "*") {
-        // Zero or more arguments
-        while (current_index < args.size() && (args[current_index][0] != '-' || is_negative_number(args[current_index]))) {
-            values.push_back(args[current_index]);
-            current_index++;
-        }
-    } else if (nargs == "+") {
-        // One or more arguments
-        if (current_index >= args.size()) {
+        count = is_list_value(args, current_index) ? 1 : 0;
+    } else if (nargs == "*" || nargs == "+") {
+        // Zero or more / one or more arguments
+        if (nargs == "+" && current_index >= args.size()) {
             throw ArgParseException("Missing value for argument: " + arg_name);
         }
-        while (current_index < args.size() && (args[current_index][0] != '-' || is_negative_number(args[current_index]))) {
-            values.push_back(args[current_index]);
-            current_index++;
+        while (is_list_value(args, current_index + count)) {
+            count++;
         }
-        if (values.empty()) {
+        if (nargs == "+" && count == 0) {
             throw ArgParseException("At least one value required for argument: " + arg_name);
         }
     } else {
         // Specific number
-        int count = std::stoi(nargs);
-        for (int i = 0; i < count; i++) {
-            if (current_index >= args.size()) {
-                throw ArgParseException("Not enough values for argument " + arg_name + " (expected " + std::to_string(count) + ")");
-            }
-            values.push_back(args[current_index]);
-            current_index++;
+        count = (size_t)std::stoi(nargs);
+        if (args.size() - current_index < count) {
+            throw ArgParseException("Not enough values for argument " + arg_name + " (expected " + std::to_string(count) + ")");
         }
     }
     
+    ArrayView<std::string> values(nullptr, args.data() + current_index, count);
+    current_index += count;
     return values;
 }
 
+// Strip a file reference prefix ("@path" or "file:path"); returns false if none
+inline bool file_reference(const std::string& value, std::string& path) {
+    if (value.size() > 1 && value[0] == '@') {
+        path = value.substr(1);
+        return true;
+    }
+    if (value.size() > 5 && value.compare(0, 5, "file:") == 0) {
+        path = value.substr(5);
+        return true;
+    }
+    return false;
+}
+
+// Lookup tables for blob decoding (-1 = invalid character)
+struct BlobTables {
+    signed char hex[256];
+    signed char base64[256];
+    BlobTables() {
+        for (int c = 0; c < 256; c++) {
+            hex[c] = base64[c] = -1;
+        }
+        for (int c = 0; c < 10; c++) hex['0' + c] = c;
+        for (int c = 0; c < 6; c++) hex['a' + c] = hex['A' + c] = 10 + c;
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int c = 0; c < 64; c++) base64[(unsigned char)alphabet[c]] = c;
+    }
+};
+inline const BlobTables blob_tables;
+
+// Check "hex:" / "base64:" encoded data or a file reference
+inline bool is_valid_blob(const std::string& str) {
+    std::string path;
+    if (file_reference(str, path)) {
+        return true;
+    }
+    if (str.compare(0, 4, "hex:") == 0) {
+        if ((str.size() - 4) % 2 != 0) return false;
+        for (size_t i = 4; i < str.size(); i++) {
+            if (blob_tables.hex[(unsigned char)str[i]] < 0) return false;
+        }
+        return true;
+    }
+    if (str.compare(0, 7, "base64:") == 0) {
+        size_t len = str.size() - 7;
+        if (len % 4 != 0) return false;
+        size_t pad = 0;
+        while (pad < 2 && pad < len && str[str.size() - 1 - pad] == '=') pad++;
+        for (size_t i = 7; i < str.size() - pad; i++) {
+            if (blob_tables.base64[(unsigned char)str[i]] < 0) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+// Decode a validated "hex:" / "base64:" value
+inline std::vector<unsigned char> decode_blob(const std::string& str) {
+    std::vector<unsigned char> out;
+    if (str.compare(0, 4, "hex:") == 0) {
+        const unsigned char* p = (const unsigned char*)str.data() + 4;
+        size_t n = (str.size() - 4) / 2;
+        out.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            out[i] = (unsigned char)((blob_tables.hex[p[2*i]] << 4) | blob_tables.hex[p[2*i + 1]]);
+        }
+    } else {
+        const unsigned char* p = (const unsigned char*)str.data() + 7;
+        size_t len = str.size() - 7;
+        size_t pad = (len > 0 && p[len - 1] == '=') + (len > 1 && p[len - 2] == '=');
+        out.resize(len / 4 * 3 - pad);
+        size_t o = 0;
+        for (size_t i = 0; i < len; i += 4) {
+            unsigned v = 0;
+            for (size_t j = 0; j < 4; j++) {
+                v = (v << 6) | (p[i + j] == '=' ? 0 : (unsigned)blob_tables.base64[p[i + j]]);
+            }
+            if (o < out.size()) out[o++] = (unsigned char)(v >> 16);
+            if (o < out.size()) out[o++] = (unsigned char)(v >> 8);
+            if (o < out.size()) out[o++] = (unsigned char)v;
+        }
+    }
+    return out;
+}
+} // namespace detail
+
 // Convert alias to key
 // '--opt-flat' -> 'opt_flat'
-std::string ArgParse::alias2key(const std::string& alias) {
+ARGPARSE_INLINE std::string alias2key(const std::string& alias) {
     bool arg_started = false;
     std::string key = "";
     for(size_t i=0; i<alias.size(); i++) {
@@ -178,70 +370,647 @@ std::string ArgParse::alias2key(const std::string& alias) {
     return key;
 }
 
-bool ArgParse::is_valid_type(const std::string& str, ArgType_t type) {
+ARGPARSE_INLINE bool is_valid_type(const std::string& str, ArgType_t type) {
     if (type == BOOL) {
         return (str == "true" || str == "1" || str == "false" || str == "0");
     }
     else if (type == INT) {
-        if (str.empty()) return false;
-        size_t start = 0;
-        // Handle negative numbers
-        if (str[0] == '-') {
-            if (str.size() == 1) return false;
-            start = 1;
+        return is_int_token(str);
+    }
+    else if (type == FLOAT) {
+        return is_float_token(str);
+    }
+    else if (type == STR || type == PATH) {
+        return true;
+    }
+    else if (type == BLOB) {
+        return detail::is_valid_blob(str);
+    }
+    else {
+        throw ArgParseException("Unknown argument type:" + std::to_string(type));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Value conversion and validation
+
+struct Pattern_t {
+    std::string source;     // Pattern text, for error messages
+    std::regex  regex;      // Compiled once at registration
+};
+
+namespace detail {
+
+// Format a bound for error messages ("1", "0.5" rather than "1.000000")
+inline std::string format_number(double value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%g", value);
+    return buf;
+}
+
+// Build "'a', 'b', 'c'" for choice errors
+inline std::string format_choices(const std::vector<std::string>& choices) {
+    std::string choices_str = "";
+    for (size_t j = 0; j < choices.size(); j++) {
+        if (j > 0) choices_str += ", ";
+        choices_str += "'" + choices[j] + "'";
+    }
+    return choices_str;
+}
+
+template<typename T> T to_value(const std::string& str);
+template<> inline bool to_value<bool>(const std::string& str) { return str == "true" || str == "1"; }
+template<> inline int to_value<int>(const std::string& str) { return std::stoi(str); }
+template<> inline float to_value<float>(const std::string& str) {
+    // Too many digits overflow (or underflow) float, as std::stoi does for int
+    errno = 0;
+    float value = strtof(str.c_str(), nullptr);
+    if (errno == ERANGE || !std::isfinite(value)) {
+        throw std::out_of_range(str);
+    }
+    return value;
+}
+template<> inline std::string to_value<std::string>(const std::string& str) { return str; }
+
+template<typename T> constexpr ArgType_t type_of() {
+    if constexpr (std::is_same_v<T, bool>) return BOOL;
+    else if constexpr (std::is_same_v<T, int>) return INT;
+    else if constexpr (std::is_same_v<T, float>) return FLOAT;
+    else return STR;
+}
+
+// Bounds and step check, only instantiated for numeric element types
+template<typename T>
+inline void check_range(const Argument_t& a, T value, const std::string& raw, const std::string& name) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "range checks need a numeric type");
+    if ((a.has_min && value < a.min_val) || (a.has_max && value > a.max_val)) {
+        std::string expected = a.has_min && a.has_max ? format_number(a.min_val) + " <= value <= " + format_number(a.max_val)
+                             : a.has_min ? "value >= " + format_number(a.min_val)
+                             : "value <= " + format_number(a.max_val);
+        throw ArgParseException("Value out of range for " + name + ": " + raw + " (expected " + expected + ")");
+    }
+    if (a.step != 0) {
+        double base = a.has_min ? a.min_val : 0;
+        bool on_step;
+        if constexpr (std::is_integral_v<T>) {
+            on_step = (static_cast<long long>(value) - static_cast<long long>(base)) % static_cast<long long>(a.step) == 0;
+        } else {
+            // value is already rounded to T, so allow for its precision
+            // in k as well as a small absolute slack for the step itself
+            double k = (value - base) / a.step;
+            double tolerance = std::max(1e-6, (std::fabs((double)value) + std::fabs(base)) *
+                                              std::numeric_limits<T>::epsilon() / std::fabs(a.step));
+            on_step = std::fabs(k - std::round(k)) <= tolerance;
+        }
+        if (!on_step) {
+            throw ArgParseException("Invalid step for " + name + ": " + raw + " (must be " + format_number(base) +
+                                    " + k*" + format_number(a.step) + ")");
+        }
+    }
+}
+
+// Validate one raw token for an argument and convert it in the same pass:
+// type syntax, choices, range/step and the custom predicate.
+template<typename T>
+inline T convert_value(const Argument_t& a, const std::string& raw, const std::string& name) {
+    constexpr ArgType_t type = type_of<T>();
+    if (!is_valid_type(raw, a.type)) {
+        const char* type_name = a.type == INT ? "integer" : a.type == FLOAT ? "float" : a.type == BLOB ? "blob" : "boolean";
+        throw ArgParseException(std::string("Invalid ") + type_name + " value for " + name + ": " + raw);
+    }
+    T value;
+    try {
+        value = to_value<T>(raw);
+    } catch (const std::out_of_range&) {
+        throw ArgParseException("Value out of range for " + name + ": " + raw);
+    }
+    if (!is_valid_choice(raw, a.choices)) {
+        throw ArgParseException("Invalid choice for " + name + ": '" + raw + "' (choose from " + format_choices(a.choices) + ")");
+    }
+    if constexpr (type == INT || type == FLOAT) {
+        if (a.has_min || a.has_max || a.step != 0) {
+            check_range<T>(a, value, raw, name);
+        }
+    }
+    if constexpr (type == STR) {
+        if (a.pattern && !std::regex_match(raw, a.pattern->regex)) {
+            throw ArgParseException("Invalid value for " + name + ": '" + raw + "' (must match '" + a.pattern->source + "')");
         }
-        for (size_t i = start; i < str.size(); i++) {
-            if (str[i] < '0' || str[i] > '9') {
-                return false;
+    }
+    if (a.validator && !a.validator(raw)) {
+        throw ArgParseException("Invalid value for " + name + ": '" + raw + "'" +
+                                (a.validator_msg.empty() ? "" : " (" + a.validator_msg + ")"));
+    }
+    return value;
+}
+
+// Minimum number of tokens handed to each conversion thread
+inline const size_t CONVERT_BATCH = 4096;
+
+// Convert a token list. With threads > 1 the list is split into contiguous
+// chunks that are converted straight into the result; the error reported is
+// the one at the lowest token index, as in a serial pass. Custom validators
+// are not assumed to be thread-safe, so they keep the list on one thread.
+template<typename T>
+inline std::vector<T> convert_values(const Argument_t& a, const ArrayView<std::string>& raw, const std::string& name,
+                                     unsigned threads = 1) {
+    size_t num_threads = std::min<size_t>(threads, (raw.size() + CONVERT_BATCH - 1) / CONVERT_BATCH);
+    if (num_threads <= 1 || a.validator) {
+        std::vector<T> values;
+        values.reserve(raw.size());
+        for (const auto& value : raw) {
+            values.push_back(convert_value<T>(a, value, name));
+        }
+        return values;
+    }
+
+    std::vector<T> values(raw.size());
+    std::atomic<size_t> first_error(raw.size());    // Lowest failing index so far
+    std::vector<std::exception_ptr> errors(num_threads);
+    auto convert_chunk = [&](size_t chunk_idx, size_t begin, size_t end) {
+        for (size_t i = begin; i < end && i < first_error.load(std::memory_order_relaxed); i++) {
+            try {
+                values[i] = convert_value<T>(a, raw[i], name);
+            } catch (...) {
+                errors[chunk_idx] = std::current_exception();
+                size_t prev = first_error.load();
+                while (i < prev && !first_error.compare_exchange_weak(prev, i)) {}
+                return;
             }
         }
-        return true;
+    };
+
+    size_t chunk = (raw.size() + num_threads - 1) / num_threads;
+    run_parallel((raw.size() + chunk - 1) / chunk, [&](size_t t) {
+        convert_chunk(t, t * chunk, std::min(t * chunk + chunk, raw.size()));
+    });
+    // Chunks are in token order: the first recorded error is the lowest index
+    for (const auto& e : errors) {
+        if (e) std::rethrow_exception(e);
     }
-    else if (type == FLOAT) {
-        if (str.empty()) return false;
-        bool decimal_point_found = false;
+    return values;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Filesystem checks
+
+// Minimum number of paths handed to each checker thread
+inline const size_t PATH_CHECK_BATCH = 1024;
+
+// Return the reason a path fails the requested checks, or nullptr if it passes
+inline const char* path_check_failure(const std::string& path, int checks) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        return "does not exist";
+    }
+    if ((checks & PATH_FILE) && !S_ISREG(st.st_mode)) {
+        return "is not a regular file";
+    }
+    if ((checks & PATH_DIR) && !S_ISDIR(st.st_mode)) {
+        return "is not a directory";
+    }
+    if ((checks & PATH_READABLE) && ::access(path.c_str(), R_OK) != 0) {
+        return "is not readable";
+    }
+    return nullptr;
+}
+
+// Check all paths, splitting long lists across threads, and report every
+// failure (in argument order) in one exception
+inline void check_paths(const ArrayView<std::string>& paths, int checks, const std::string& name) {
+    if (checks == 0 || paths.empty()) {
+        return;
+    }
+
+    std::vector<const char*> failures(paths.size(), nullptr);
+    auto check_chunk = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            failures[i] = path_check_failure(paths[i], checks);
+        }
+    };
+
+    size_t num_threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                          (paths.size() + PATH_CHECK_BATCH - 1) / PATH_CHECK_BATCH);
+    if (num_threads <= 1) {
+        check_chunk(0, paths.size());
+    } else {
+        size_t chunk = (paths.size() + num_threads - 1) / num_threads;
+        run_parallel((paths.size() + chunk - 1) / chunk, [&](size_t t) {
+            check_chunk(t * chunk, std::min(t * chunk + chunk, paths.size()));
+        });
+    }
+
+    std::string message;
+    size_t num_failed = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (failures[i]) {
+            message += "\n  '" + paths[i] + "' " + failures[i];
+            num_failed++;
+        }
+    }
+    if (num_failed > 0) {
+        throw ArgParseException("Invalid path" + std::string(num_failed > 1 ? "s" : "") + " for " + name + " (" +
+                                std::to_string(num_failed) + " of " + std::to_string(paths.size()) + "):" + message);
+    }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Glob expansion
+
+inline bool has_glob_chars(const std::string& str) {
+    return str.find_first_of("*?[") != std::string::npos;
+}
+
+inline std::string join_path(const std::string& base, const std::string& name) {
+    if (base.empty()) return name;
+    if (base.back() == '/') return base + name;
+    return base + "/" + name;
+}
+
+// List a directory as (name, is_dir) pairs, skipping "." and ".."
+inline std::vector<std::pair<std::string, bool>> list_dir(const std::string& dir) {
+    std::vector<std::pair<std::string, bool>> entries;
+    DIR* d = opendir(dir.empty() ? "." : dir.c_str());
+    if (!d) {
+        return entries;
+    }
+    while (struct dirent* e = readdir(d)) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        bool is_dir = e->d_type == DT_DIR;
+        if (e->d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = ::lstat(join_path(dir, e->d_name).c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+        }
+        entries.emplace_back(e->d_name, is_dir);
+    }
+    closedir(d);
+    return entries;
+}
+
+// Matches one glob pattern, split into path components
+class GlobWalker {
+public:
+    GlobWalker(const std::string& pattern, size_t max_matches): max_matches_(max_matches) {
         size_t start = 0;
-        // Handle negative numbers
-        if (str[0] == '-') {
-            if (str.size() == 1) return false;
+        if (!pattern.empty() && pattern[0] == '/') {
+            root_ = "/";
             start = 1;
         }
-        for (size_t i = start; i < str.size(); i++) {
-            if (str[i] < '0' || str[i] > '9') {
-                if (str[i] == '.' && !decimal_point_found && i != str.size()-1) {
-                    decimal_point_found = true;
-                    continue;
+        while (start <= pattern.size()) {
+            size_t end = pattern.find('/', start);
+            if (end == std::string::npos) end = pattern.size();
+            if (end > start) parts_.push_back(pattern.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    // Expand the pattern; the first wildcard directory level is fanned out over threads
+    std::vector<std::string> expand() {
+        // Walk the literal prefix without touching the filesystem
+        std::string base = root_;
+        size_t idx = 0;
+        while (idx < parts_.size() && !has_glob_chars(parts_[idx])) {
+            base = join_path(base, parts_[idx++]);
+        }
+
+        // Work items for the first wildcard level
+        std::vector<std::pair<std::string, size_t>> items;
+        if (idx == parts_.size()) {
+            items.emplace_back(base, idx);
+        } else if (parts_[idx] == "**") {
+            items.emplace_back(base, idx + 1);
+            for (const auto& e : list_dir(base)) {
+                if (e.second && e.first[0] != '.') items.emplace_back(join_path(base, e.first), idx);
+            }
+        } else {
+            for (const auto& e : list_dir(base)) {
+                if (fnmatch(parts_[idx].c_str(), e.first.c_str(), FNM_PERIOD) == 0 && (e.second || idx + 1 == parts_.size())) {
+                    items.emplace_back(join_path(base, e.first), idx + 1);
                 }
-                else {
-                    return false;
+            }
+        }
+
+        std::vector<std::vector<std::string>> results(items.size());
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next++; i < items.size() && !overflow_; i = next++) {
+                walk(items[i].first, items[i].second, results[i]);
+            }
+        };
+        size_t num_threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), items.size());
+        if (num_threads <= 1) {
+            worker();
+        } else {
+            run_parallel(num_threads, [&](size_t) { worker(); });
+        }
+
+        std::vector<std::string> matches;
+        for (auto& r : results) {
+            matches.insert(matches.end(), std::make_move_iterator(r.begin()), std::make_move_iterator(r.end()));
+        }
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+        return matches;
+    }
+
+    bool overflow() const { return overflow_; }
+
+private:
+    std::string root_;
+    std::vector<std::string> parts_;
+    size_t max_matches_;
+    std::atomic<size_t> count_{0};
+    std::atomic<bool> overflow_{false};
+
+    void add_match(const std::string& path, std::vector<std::string>& out) {
+        if (max_matches_ != 0 && ++count_ > max_matches_) {
+            overflow_ = true;
+            return;
+        }
+        out.push_back(path);
+    }
+
+    void walk(const std::string& base, size_t idx, std::vector<std::string>& out) {
+        if (overflow_) return;
+        if (idx == parts_.size()) {
+            struct stat st;
+            if (::lstat(base.c_str(), &st) == 0) add_match(base, out);
+            return;
+        }
+        const std::string& part = parts_[idx];
+        if (part == "**") {
+            walk(base, idx + 1, out);
+            for (const auto& e : list_dir(base)) {
+                if (e.second && e.first[0] != '.') walk(join_path(base, e.first), idx, out);
+            }
+        } else if (!has_glob_chars(part)) {
+            walk(join_path(base, part), idx + 1, out);
+        } else {
+            bool last = idx + 1 == parts_.size();
+            for (const auto& e : list_dir(base)) {
+                if ((e.second || last) && fnmatch(part.c_str(), e.first.c_str(), FNM_PERIOD) == 0) {
+                    if (last) add_match(join_path(base, e.first), out);
+                    else walk(join_path(base, e.first), idx + 1, out);
                 }
             }
         }
-        return true;
     }
-    else if (type == STR) {
-        return true;
+};
+
+// Replace every wildcard value with its sorted matches
+inline std::vector<std::string> expand_globs(const ArrayView<std::string>& values, size_t max_matches, const std::string& name) {
+    std::vector<std::string> expanded;
+    expanded.reserve(values.size());
+    for (const auto& value : values) {
+        if (!has_glob_chars(value)) {
+            expanded.push_back(value);
+            continue;
+        }
+        GlobWalker walker(value, max_matches);
+        std::vector<std::string> matches = walker.expand();
+        if (walker.overflow()) {
+            throw ArgParseException("Too many matches for " + name + ": '" + value + "' (limit " + std::to_string(max_matches) + ")");
+        }
+        if (matches.empty()) {
+            throw ArgParseException("No matches for " + name + ": '" + value + "'");
+        }
+        expanded.insert(expanded.end(), std::make_move_iterator(matches.begin()), std::make_move_iterator(matches.end()));
     }
-    else {
-        throw ArgParseException("Unknown argument type:" + std::to_string(type));
+    return expanded;
+}
+
+// Convert a single token into an ArgVal_t of the argument's type
+inline ArgVal_t convert_arg(const Argument_t& a, const std::string& raw, const std::string& name) {
+    ArgVal_t val = {a.type, false};
+    switch (a.type) {
+        case BOOL:  val.value = convert_value<bool>(a, raw, name); break;
+        case INT:   val.value = convert_value<int>(a, raw, name); break;
+        case FLOAT: val.value = convert_value<float>(a, raw, name); break;
+        case STR:   val.value = convert_value<std::string>(a, raw, name); break;
+        case PATH:
+            val.value = convert_value<std::string>(a, raw, name);
+            check_paths(ArrayView<std::string>(nullptr, &raw, 1), a.path_checks, name);
+            break;
+        case BLOB:  val.value = convert_value<std::string>(a, raw, name); break;
+        default:
+            throw ArgParseException("Unknown argument type for " + name);
+    }
+    return val;
+}
+
+// Convert an nargs token list into an ArgVal_t holding a vector
+inline ArgVal_t convert_arg_list(const Argument_t& a, const ArrayView<std::string>& raw, const std::string& name,
+                                 unsigned threads = 1) {
+    ArgVal_t val = {a.type, false};
+    switch (a.type) {
+        case INT:   val.value = convert_values<int>(a, raw, name, threads); break;
+        case FLOAT: val.value = convert_values<float>(a, raw, name, threads); break;
+        case STR:   val.value = convert_values<std::string>(a, raw, name, threads); break;
+        case PATH:
+            val.value = convert_values<std::string>(a, raw, name, threads);
+            check_paths(raw, a.path_checks, name);
+            break;
+        case BLOB:  val.value = convert_values<std::string>(a, raw, name, threads); break;
+        default:
+            throw ArgParseException("Unknown argument type for " + name);
+    }
+    return val;
+}
+} // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Memory-mapped files
+
+struct MappedFile {
+    std::string path;
+    std::once_flag once;
+    const char* data = nullptr;
+    size_t size = 0;
+
+    explicit MappedFile(const std::string& p): path(p) {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (data && size > 0) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    // Map the file on first use; a failed attempt is retried on the next call
+    void load() {
+        std::call_once(once, [this]() {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw ArgParseException("Cannot open file: " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                ::close(fd);
+                throw ArgParseException("Not a regular file: " + path);
+            }
+            size_t len = (size_t)st.st_size;
+            if (len > 0) {
+                void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    throw ArgParseException("Cannot map file: " + path);
+                }
+                data = static_cast<const char*>(p);
+            }
+            size = len;
+            ::close(fd);
+        });
+    }
+};
+
+ARGPARSE_INLINE const char* FileView::data() const {
+    if (file_) {
+        file_->load();
+        return file_->data ? file_->data : "";
+    }
+    return inline_.data();
+}
+
+ARGPARSE_INLINE size_t FileView::size() const {
+    if (file_) {
+        file_->load();
+        return file_->size;
+    }
+    return inline_.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Binary numeric arrays
+
+namespace detail {
+
+inline bool host_is_little_endian() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Extract 'descr' and the element count from a .npy header dict, e.g.
+// "{'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), }"
+inline bool parse_npy_header(const std::string& header, std::string& descr, size_t& count) {
+    size_t d = header.find("'descr'");
+    size_t s = header.find("'shape'");
+    if (d == std::string::npos || s == std::string::npos) return false;
+    size_t q1 = header.find('\'', header.find(':', d) + 1);
+    size_t q2 = q1 == std::string::npos ? q1 : header.find('\'', q1 + 1);
+    if (q2 == std::string::npos) return false;
+    descr = header.substr(q1 + 1, q2 - q1 - 1);
+
+    size_t open = header.find('(', s);
+    size_t close = open == std::string::npos ? open : header.find(')', open);
+    if (close == std::string::npos) return false;
+    count = 1;
+    std::string dims = header.substr(open + 1, close - open - 1);
+    size_t pos = 0;
+    while (pos < dims.size()) {
+        size_t end = dims.find(',', pos);
+        if (end == std::string::npos) end = dims.size();
+        std::string dim = dims.substr(pos, end - pos);
+        dim.erase(std::remove(dim.begin(), dim.end(), ' '), dim.end());
+        if (!dim.empty()) {
+            // Checked parse: the element count must fit in bytes as size_t
+            const size_t limit = SIZE_MAX / 4;
+            size_t n = 0;
+            for (char c : dim) {
+                if (c < '0' || c > '9') return false;
+                size_t digit = (size_t)(c - '0');
+                if (n > (limit - digit) / 10) return false;
+                n = n * 10 + digit;
+            }
+            if (n != 0 && count > limit / n) return false;
+            count *= n;
+        }
+        pos = end + 1;
+    }
+    return true;
+}
+
+// Full pass over array data for finiteness and range checks. The loop only
+// accumulates a flag so the compiler can vectorize it; the offending element
+// is located in a second pass on failure.
+template<typename T>
+inline void scan_array(const T* data, size_t n, const Argument_t& a, const std::string& name) {
+    const bool check_finite = std::is_floating_point_v<T> && a.array_check_finite;
+    T lo = std::numeric_limits<T>::lowest();
+    T hi = std::numeric_limits<T>::max();
+    if (a.has_min) lo = std::is_integral_v<T> ? static_cast<T>(std::ceil(a.min_val)) : static_cast<T>(a.min_val);
+    if (a.has_max) hi = std::is_integral_v<T> ? static_cast<T>(std::floor(a.max_val)) : static_cast<T>(a.max_val);
+
+    int ok = 1;
+    for (size_t i = 0; i < n; i++) {
+        T x = data[i];
+        ok &= (x >= lo) & (x <= hi);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (check_finite) ok &= (x - x) == 0;
+        }
+    }
+    if (ok) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        T x = data[i];
+        if (std::is_floating_point_v<T> && check_finite && !std::isfinite((double)x)) {
+            throw ArgParseException("Non-finite value in array for " + name + " at element " + std::to_string(i));
+        }
+        if (!(x >= lo && x <= hi)) {
+            throw ArgParseException("Value out of range in array for " + name + " at element " + std::to_string(i) +
+                                    ": " + format_number((double)x));
+        }
     }
 }
+} // namespace detail
 
 
 ////////////////////////////////////////////////////////////////////////////////
 // ArgumentParser Class
 
-ArgumentParser::ArgumentParser(const std::string& prog_name, const std::string& description, const std::string& epilog):
-    prog_name_(prog_name),
-    description_(description),
-    epilog_(epilog) 
+ARGPARSE_INLINE ArgumentParser::ArgumentParser(const std::string& prog_name, const std::string& description, const std::string& epilog):
+    impl_(new Impl)
 {
+    impl_->prog_name_ = prog_name;
+    impl_->description_ = description;
+    impl_->epilog_ = epilog;
+
     // Add help argument
     add_argument({"-h", "--help"}, "Show this help message and exit");
 }
 
+ARGPARSE_INLINE ArgumentParser::ArgumentParser(const ArgumentParser& other):
+    impl_(new Impl(*other.impl_)),
+    parsed_args_(other.parsed_args_),
+    parsed_pos_args_(other.parsed_pos_args_),
+    out_(other.out_),
+    err_(other.err_)
+{
+}
+
+ARGPARSE_INLINE ArgumentParser& ArgumentParser::operator=(const ArgumentParser& other) {
+    if (this != &other) {
+        *this = ArgumentParser(other);
+    }
+    return *this;
+}
+
+ARGPARSE_INLINE ArgumentParser::ArgumentParser(ArgumentParser&& other) noexcept = default;
+ARGPARSE_INLINE ArgumentParser& ArgumentParser::operator=(ArgumentParser&& other) noexcept = default;
+ARGPARSE_INLINE ArgumentParser::~ArgumentParser() = default;
 
-void ArgumentParser::add_argument(const std::vector<std::string>& aliases, const std::string& help, ArgType_t type, 
+
+ARGPARSE_INLINE std::string ArgumentParser::add_argument(const std::vector<std::string>& aliases, const std::string& help, ArgType_t type, 
     const std::string& defaultval, bool required, const std::string& key, const std::vector<std::string>& choices, const std::string& metavar, const std::string& nargs) {
     
     if(aliases.size() == 0) {
@@ -253,7 +1022,7 @@ void ArgumentParser::add_argument(const std::vector<std::string>& aliases, const
     }
 
     // Validate nargs format
-    if (!is_valid_nargs(nargs)) {
+    if (!detail::is_valid_nargs(nargs)) {
         throw ArgParseException("Invalid nargs format: " + nargs);
     }
 
@@ -305,8 +1074,8 @@ void ArgumentParser::add_argument(const std::vector<std::string>& aliases, const
             arg.defaultval.type = FLOAT;
             arg.defaultval.value = strtof(defaultval.c_str(), nullptr);
         }
-        else if (type == STR) {
-            arg.defaultval.type = STR;
+        else if (type == STR || type == PATH || type == BLOB) {
+            arg.defaultval.type = type;
             arg.defaultval.value = defaultval;
         }
         else {
@@ -325,362 +1094,1161 @@ void ArgumentParser::add_argument(const std::vector<std::string>& aliases, const
     
     // Set nargs
     arg.nargs = nargs;
+
+    arg.group = impl_->current_group_;
     
     // Add to appropriate list
-    arg_list_.push_back(arg);
+    impl_->arg_list_.push_back(arg);
+    impl_->help_index_.clear();
     if (arg.is_positional) {
-        pos_arg_list_.push_back(arg);
+        impl_->pos_arg_list_.push_back(impl_->arg_list_.size() - 1);
+    } else {
+        // First definition of an alias wins
+        for (const auto& alias : arg.aliases) {
+            impl_->alias_index_.emplace(alias, impl_->arg_list_.size() - 1);
+        }
     }
+    return impl_->arg_list_.back().key;
 }
 
 
-int ArgumentParser::parse_args(int argc, char **argv) {
-    std::vector<std::string> args;
-    for (int i = 0; i < argc; i++) {
-        args.push_back(std::string(argv[i]));
+ARGPARSE_INLINE Argument_t& ArgumentParser::find_argument(const std::string& key) {
+    // Callers modify the spec, so rendered help must be rebuilt
+    impl_->help_entries_.clear();
+    impl_->help_index_.clear();
+    for (auto& a : impl_->arg_list_) {
+        if (a.key == key) {
+            return a;
+        }
     }
-    return parse_args(args);
+    throw ArgParseException("Unknown argument key: " + key);
 }
 
-int ArgumentParser::parse_args(const std::vector<std::string>& args) {
-    // TODO: Need to check alias collisions
 
-    args_.clear();
-    args_ = args;   // copy input args
+ARGPARSE_INLINE const ArgVal_t& ArgumentParser::find_value(const std::string& key) const {
+    auto it = parsed_args_.find(key);
+    if (it == parsed_args_.end()) {
+        throw std::runtime_error("Argument key '" + key + "' not found. Make sure you defined it with add_argument().");
+    }
+    return it->second;
+}
 
-    parsed_args_.clear();
-    parsed_pos_args_.clear();
+ARGPARSE_INLINE void ArgumentParser::throw_type_mismatch(const std::string& key, const char* requested, const ArgVal_t& value) {
+    // Names in the order of ArgVal_t::value's alternatives
+    static const char* const actual_names[] = {
+        "bool", "int", "float", "std::string", "std::vector<int>", "std::vector<float>", "std::vector<std::string>"
+    };
+    size_t idx = value.value.index();
+    const char* actual = idx < sizeof(actual_names) / sizeof(actual_names[0]) ? actual_names[idx] : "unknown";
+    throw std::runtime_error("Type mismatch for argument '" + key + "'. Expected: " + requested + ", Got: " + actual);
+}
 
-    try {
-        // Take program name from args if not set
-        if (prog_name_.size() == 0) {
-            prog_name_ = args_[0];
-        }
+ARGPARSE_INLINE void ArgumentParser::set_range(const std::string& key, double min_val, double max_val, double step) {
+    if (min_val > max_val) {
+        throw ArgParseException("Invalid range for " + key + ": min is greater than max");
+    }
+    Argument_t& a = find_argument(key);
+    if (step < 0 || (a.type == INT && step != std::floor(step))) {
+        throw ArgParseException("Invalid step for " + key + ": " + detail::format_number(step));
+    }
+    set_min(key, min_val);
+    set_max(key, max_val);
+    a.step = step;
+}
 
-        // Track which arguments were provided (not just initialized)
-        std::set<std::string> provided_args;
-        
-        // add bool args and set default values
-        for (auto &a: arg_list_) {
-            if (a.type == BOOL) {
-                // All BOOL args get added with false as default
-                parsed_args_[a.key].type = BOOL;
-                parsed_args_[a.key].value = false;
-            }
-            else if(a.defaultval.type != UNK) {
-                // Non-BOOL args with explicit defaults
-                parsed_args_[a.key].type = a.type;
-                parsed_args_[a.key] = a.defaultval;
-                provided_args.insert(a.key);  // Defaults count as provided
+
+ARGPARSE_INLINE void ArgumentParser::set_min(const std::string& key, double min_val) {
+    Argument_t& a = find_argument(key);
+    if (a.type != INT && a.type != FLOAT && a.array_type == UNK) {
+        throw ArgParseException("Range constraints require an INT or FLOAT argument: " + key);
+    }
+    a.has_min = true;
+    a.min_val = min_val;
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_max(const std::string& key, double max_val) {
+    Argument_t& a = find_argument(key);
+    if (a.type != INT && a.type != FLOAT && a.array_type == UNK) {
+        throw ArgParseException("Range constraints require an INT or FLOAT argument: " + key);
+    }
+    a.has_max = true;
+    a.max_val = max_val;
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_validator(const std::string& key, std::function<bool(const std::string&)> validator, const std::string& message) {
+    Argument_t& a = find_argument(key);
+    a.validator = std::move(validator);
+    a.validator_msg = message;
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_pattern(const std::string& key, const std::string& pattern) {
+    Argument_t& a = find_argument(key);
+    if (a.type != STR) {
+        throw ArgParseException("Pattern constraints require a STR argument: " + key);
+    }
+    try {
+        a.pattern = std::make_shared<const Pattern_t>(Pattern_t{pattern, std::regex(pattern, std::regex::ECMAScript | std::regex::optimize)});
+    } catch (const std::regex_error& e) {
+        throw ArgParseException("Invalid pattern for " + key + ": '" + pattern + "' (" + e.what() + ")");
+    }
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_path_checks(const std::string& key, int checks) {
+    Argument_t& a = find_argument(key);
+    if (a.type != PATH) {
+        throw ArgParseException("Path checks require a PATH argument: " + key);
+    }
+    a.path_checks = checks;
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_glob(const std::string& key, size_t max_matches) {
+    Argument_t& a = find_argument(key);
+    if ((a.type != STR && a.type != PATH) || a.nargs.empty() || a.nargs == "1") {
+        throw ArgParseException("Glob expansion requires a STR or PATH argument with nargs: " + key);
+    }
+    a.glob = true;
+    a.glob_max = max_matches;
+}
+
+ARGPARSE_INLINE void ArgumentParser::set_parallel_conversion(size_t min_values, unsigned threads) {
+    impl_->parallel_min_ = min_values;
+    impl_->parallel_threads_ = threads;
+}
+
+ARGPARSE_INLINE void ArgumentParser::set_array(const std::string& key, ArgType_t elem_type, bool check_finite) {
+    Argument_t& a = find_argument(key);
+    if (a.type != STR && a.type != PATH) {
+        throw ArgParseException("Array files require a STR or PATH argument: " + key);
+    }
+    if (elem_type != INT && elem_type != FLOAT) {
+        throw ArgParseException("Array element type must be INT or FLOAT: " + key);
+    }
+    a.array_type = elem_type;
+    a.array_check_finite = check_finite;
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::load_arrays() {
+    impl_->arrays_.clear();
+    for (const auto& a : impl_->arg_list_) {
+        if (a.array_type == UNK) continue;
+        auto it = parsed_args_.find(a.key);
+        const std::string* path = it == parsed_args_.end() ? nullptr : std::get_if<std::string>(&it->second.value);
+        if (!path || path->empty()) continue;
+
+        if (!detail::host_is_little_endian()) {
+            throw ArgParseException("Array files require a little-endian host: " + a.key);
+        }
+        auto file = std::make_shared<MappedFile>(*path);
+        file->load();
+        const char* base = file->data;
+        size_t len = file->size;
+        size_t offset = 0;
+        size_t count = len / 4;
+        const char* expected_descr = a.array_type == INT ? "<i4" : "<f4";
+
+        if (len >= 10 && memcmp(base, "\x93NUMPY", 6) == 0) {
+            unsigned char major = (unsigned char)base[6];
+            size_t header_len;
+            if (major == 1) {
+                header_len = (unsigned char)base[8] | ((unsigned char)base[9] << 8);
+                offset = 10;
+            } else if (major == 2 || major == 3) {
+                if (len < 12) throw ArgParseException("Truncated .npy header in " + *path);
+                uint32_t hl;
+                memcpy(&hl, base + 8, 4);
+                header_len = hl;
+                offset = 12;
+            } else {
+                throw ArgParseException("Unsupported .npy version in " + *path);
             }
-            else {
-                // Non-BOOL args without defaults - initialize based on nargs
-                parsed_args_[a.key].type = a.type;
-                
-                // If nargs is specified and not "1", initialize as vector
-                if (!a.nargs.empty() && a.nargs != "1") {
-                    switch(a.type) {
-                        case INT:
-                            parsed_args_[a.key].value = std::vector<int>();
-                            break;
-                        case FLOAT:
-                            parsed_args_[a.key].value = std::vector<float>();
-                            break;
-                        case STR:
-                            parsed_args_[a.key].value = std::vector<std::string>();
-                            break;
-                        default:
-                            break;
-                    }
-                } else {
-                    // Single value initialization
-                    switch(a.type) {
-                        case INT:
-                            parsed_args_[a.key].value = 0;
-                            break;
-                        case FLOAT:
-                            parsed_args_[a.key].value = 0.0f;
-                            break;
-                        case STR:
-                            parsed_args_[a.key].value = std::string("");
-                            break;
-                        default:
-                            break;
-                    }
-                }
+            if (offset + header_len > len) {
+                throw ArgParseException("Truncated .npy header in " + *path);
+            }
+            std::string descr;
+            if (!detail::parse_npy_header(std::string(base + offset, header_len), descr, count)) {
+                throw ArgParseException("Malformed .npy header in " + *path);
+            }
+            if (descr != expected_descr) {
+                throw ArgParseException("Array dtype mismatch in " + *path + ": '" + descr + "' (expected '" + expected_descr + "')");
+            }
+            offset += header_len;
+            if ((len - offset) % 4 != 0 || (len - offset) / 4 != count) {
+                throw ArgParseException("Array length mismatch in " + *path + ": header has " + std::to_string(count) +
+                                        " elements, file has " + std::to_string((len - offset) / 4));
             }
+        } else if (len % 4 != 0) {
+            throw ArgParseException("Raw array size is not a multiple of 4 bytes: " + *path);
         }
+        if (offset % 4 != 0) {
+            throw ArgParseException("Misaligned array data in " + *path);
+        }
+
+        const void* data = base + offset;
+        if (a.array_check_finite || a.has_min || a.has_max) {
+            if (a.array_type == INT) detail::scan_array(static_cast<const int*>(data), count, a, a.key);
+            else detail::scan_array(static_cast<const float*>(data), count, a, a.key);
+        }
+        impl_->arrays_[a.key] = ArrayData_t{file, data, count, a.array_type};
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// List files (--files-from)
+
+namespace detail {
+
+// Read size of streamed lists; entries cut by a block end move to the next block
+inline const size_t FILES_FROM_BLOCK = 1 << 20;
+
+// Entries of one list and the storage their views point into
+struct FileListData_t {
+    std::shared_ptr<MappedFile> file;                   // Mapped list (regular files)
+    std::vector<std::unique_ptr<char[]>> blocks;        // Arena for streamed lists
+    std::vector<std::string_view> entries;
+};
+
+// Split mapped data on delim. The entry count is found first so the index is allocated once
+inline void split_list(std::string_view data, char delim, FileListData_t& list,
+                       const std::function<void(std::string_view)>& visitor) {
+    if (!visitor) {
+        size_t count = 0;
+        for (const char* p = data.data(), *end = p + data.size(); p < end; count++) {
+            const char* q = static_cast<const char*>(memchr(p, delim, end - p));
+            p = q ? q + 1 : end;
+        }
+        list.entries.reserve(count);
+    }
+    const char* p = data.data();
+    const char* end = p + data.size();
+    while (p < end) {
+        const char* q = static_cast<const char*>(memchr(p, delim, end - p));
+        const char* stop = q ? q : end;
+        if (stop > p) {
+            if (visitor) visitor(std::string_view(p, stop - p));
+            else list.entries.emplace_back(p, stop - p);
+        }
+        p = stop + 1;
+    }
+}
+
+// Read delimited entries from fd to end of input, in FILES_FROM_BLOCK reads
+inline void stream_list(int fd, const std::string& source, char delim, FileListData_t& list,
+                        const std::function<void(std::string_view)>& visitor) {
+    size_t cap = FILES_FROM_BLOCK;
+    std::unique_ptr<char[]> block(new char[cap]);
+    size_t len = 0;     // Bytes in block
+    size_t start = 0;   // Start of the entry being read
+
+    auto emit = [&](size_t from, size_t to) {
+        if (to == from) return;
+        std::string_view entry(block.get() + from, to - from);
+        if (visitor) visitor(entry);
+        else list.entries.push_back(entry);
+    };
+
+    while (true) {
+        if (len == cap) {
+            size_t partial = len - start;
+            if (visitor && start > 0) {
+                // Entries so far were visited: reuse the block
+                memmove(block.get(), block.get() + start, partial);
+            } else {
+                // Stored entries point into this block: keep it, continue in a new one
+                size_t new_cap = std::max(FILES_FROM_BLOCK, partial * 2);
+                std::unique_ptr<char[]> next(new char[new_cap]);
+                memcpy(next.get(), block.get() + start, partial);
+                if (!visitor) list.blocks.push_back(std::move(block));
+                block = std::move(next);
+                cap = new_cap;
+            }
+            len = partial;
+            start = 0;
+        }
+        ssize_t n = ::read(fd, block.get() + len, cap - len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw ArgParseException("Cannot read list: " + source);
+        }
+        if (n == 0) {
+            break;
+        }
+        const char* end = block.get() + len + n;
+        const char* p = block.get() + len;
+        while (const char* q = static_cast<const char*>(memchr(p, delim, end - p))) {
+            emit(start, q - block.get());
+            start = q - block.get() + 1;
+            p = q + 1;
+        }
+        len += (size_t)n;
+    }
+    emit(start, len);
+    if (!visitor) list.blocks.push_back(std::move(block));
+}
+} // namespace detail
+
+ARGPARSE_INLINE void ArgumentParser::set_files_from(const std::string& key, char delimiter,
+                                                    std::function<void(std::string_view)> visitor) {
+    Argument_t& a = find_argument(key);
+    if ((a.type != STR && a.type != PATH) || a.is_positional || !(a.nargs.empty() || a.nargs == "1")) {
+        throw ArgParseException("List files require a single-value STR or PATH option: " + key);
+    }
+    a.files_from = true;
+    a.files_from_delim = delimiter;
+    a.files_from_visitor = std::move(visitor);
+}
+
+ARGPARSE_INLINE void ArgumentParser::load_file_lists() {
+    impl_->file_lists_.clear();
+    for (size_t k = 0; k < impl_->arg_list_.size(); k++) {
+        const Argument_t& a = impl_->arg_list_[k];
+        if (!a.files_from || !impl_->provided_[k]) continue;
+        const std::string* source = std::get_if<std::string>(&parsed_args_[a.key].value);
+        if (!source || source->empty()) continue;
+
+        auto list = std::make_shared<detail::FileListData_t>();
+        struct stat st;
+        if (*source != "-" && ::stat(source->c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            list->file = std::make_shared<MappedFile>(*source);
+            list->file->load();
+            detail::split_list(std::string_view(list->file->data ? list->file->data : "", list->file->size),
+                       a.files_from_delim, *list, a.files_from_visitor);
+        } else if (*source == "-") {
+            detail::stream_list(0, "stdin", a.files_from_delim, *list, a.files_from_visitor);
+        } else {
+            // Pipes, FIFOs and process substitutions cannot be mapped
+            int fd = ::open(source->c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw ArgParseException("Cannot open file: " + *source);
+            }
+            try {
+                detail::stream_list(fd, *source, a.files_from_delim, *list, a.files_from_visitor);
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+        }
+        // The view shares ownership of the whole list (aliasing constructor: no MappedFile object)
+        std::shared_ptr<const MappedFile> owner(list, static_cast<const MappedFile*>(nullptr));
+        impl_->file_lists_[a.key] = ArrayView<std::string_view>(owner, list->entries.data(), list->entries.size());
+    }
+}
+
+ARGPARSE_INLINE ArrayView<std::string_view> ArgumentParser::get_file_list(const std::string& key) const {
+    auto it = impl_->file_lists_.find(key);
+    if (it != impl_->file_lists_.end()) {
+        return it->second;
+    }
+    for (const auto& a : impl_->arg_list_) {
+        if (a.key == key && a.files_from) {
+            return {};
+        }
+    }
+    throw std::runtime_error("Argument '" + key + "' is not a list file. Make sure it was set with set_files_from().");
+}
+
+
+ARGPARSE_INLINE const ArgumentParser::ArrayData_t& ArgumentParser::find_array(const std::string& key, ArgType_t type) const {
+    auto it = impl_->arrays_.find(key);
+    if (it == impl_->arrays_.end()) {
+        throw std::runtime_error("No array mapped for argument '" + key + "'. Make sure it was set with set_array() and given a file.");
+    }
+    if (it->second.type != type) {
+        throw std::runtime_error("Type mismatch for array argument '" + key + "'. Expected: " +
+                                 (type == INT ? "int" : "float") + ", Got: " + (it->second.type == INT ? "int" : "float"));
+    }
+    return it->second;
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_action(const std::string& key, std::function<ActionResult_t(const ArgVal_t&)> action, bool early_exit) {
+    Argument_t& a = find_argument(key);
+    if (a.is_positional) {
+        throw ArgParseException("Actions require an optional argument: " + key);
+    }
+    if (early_exit && a.type != BOOL) {
+        throw ArgParseException("Early-exit actions require a BOOL flag: " + key);
+    }
+    a.action = std::move(action);
+    a.early_exit = early_exit;
+}
+
+ARGPARSE_INLINE void ArgumentParser::begin_group(const std::string& name, const std::string& description) {
+    if (name.empty()) {
+        throw ArgParseException("Group name cannot be empty");
+    }
+    auto it = std::find_if(impl_->groups_.begin(), impl_->groups_.end(), [&](const Group_t& g) { return g.name == name; });
+    if (it == impl_->groups_.end()) {
+        impl_->groups_.push_back({name, description, {}, nullptr});
+    } else if (it->registrar) {
+        throw ArgParseException("Group is registered lazily: " + name);
+    } else if (!description.empty()) {
+        it->description = description;
+    }
+    impl_->current_group_ = name;
+}
+
+ARGPARSE_INLINE void ArgumentParser::end_group() {
+    impl_->current_group_.clear();
+}
+
+ARGPARSE_INLINE void ArgumentParser::add_lazy_group(const std::string& name, const std::string& description,
+                                    const std::vector<std::string>& aliases,
+                                    std::function<void(ArgumentParser&)> registrar) {
+    if (name.empty() || !registrar) {
+        throw ArgParseException("Lazy group needs a name and a registrar: " + name);
+    }
+    for (const auto& g : impl_->groups_) {
+        if (g.name == name) {
+            throw ArgParseException("Duplicate group: " + name);
+        }
+    }
+    if (aliases.empty()) {
+        throw ArgParseException("Lazy group claims no options: " + name);
+    }
+    for (const auto& alias : aliases) {
+        if (alias.size() < 2 || alias[0] != '-') {
+            throw ArgParseException("Lazy group aliases must be options: " + alias);
+        }
+        if (impl_->alias_index_.count(alias) || impl_->lazy_alias_index_.count(alias)) {
+            throw ArgParseException("Alias already defined: " + alias);
+        }
+    }
+    impl_->groups_.push_back({name, description, aliases, std::move(registrar)});
+    for (const auto& alias : aliases) {
+        impl_->lazy_alias_index_.emplace(alias, impl_->groups_.size() - 1);
+    }
+}
+
+ARGPARSE_INLINE void ArgumentParser::load_group(size_t idx) {
+    if (!impl_->groups_[idx].registrar) {
+        return;
+    }
+    // Detach first: the registrar may add groups (reallocating impl_->groups_)
+    auto registrar = std::move(impl_->groups_[idx].registrar);
+    impl_->groups_[idx].registrar = nullptr;
+    for (const auto& alias : impl_->groups_[idx].aliases) {
+        impl_->lazy_alias_index_.erase(alias);
+    }
+
+    // Arguments the registrar adds belong to the group, whatever happens
+    struct GroupScope {
+        std::string& current;
+        std::string outer;
+        ~GroupScope() { current = std::move(outer); }
+    } scope{impl_->current_group_, impl_->current_group_};
+    impl_->current_group_ = impl_->groups_[idx].name;
+
+    size_t num_args = impl_->arg_list_.size();
+    size_t num_positional = impl_->pos_arg_list_.size();
+    size_t num_groups = impl_->groups_.size();
+    try {
+        registrar(*this);
+        if (impl_->pos_arg_list_.size() != num_positional) {
+            throw ArgParseException("Lazy group cannot define positional arguments: " + impl_->groups_[idx].name);
+        }
+    } catch (...) {
+        // Undo the partial registration and leave the group unloaded
+        Impl& im = *impl_;
+        im.arg_list_.erase(im.arg_list_.begin() + num_args, im.arg_list_.end());
+        im.pos_arg_list_.resize(num_positional);
+        for (auto it = im.alias_index_.begin(); it != im.alias_index_.end();) {
+            it = it->second >= num_args ? im.alias_index_.erase(it) : std::next(it);
+        }
+        for (auto it = im.lazy_alias_index_.begin(); it != im.lazy_alias_index_.end();) {
+            it = it->second >= num_groups ? im.lazy_alias_index_.erase(it) : std::next(it);
+        }
+        im.groups_.erase(im.groups_.begin() + num_groups, im.groups_.end());
+        im.groups_[idx].registrar = std::move(registrar);
+        for (const auto& alias : im.groups_[idx].aliases) {
+            im.lazy_alias_index_.emplace(alias, idx);
+        }
+        im.help_entries_.clear();
+        im.help_index_.clear();
+        throw;
+    }
+}
+
+ARGPARSE_INLINE bool ArgumentParser::init_default(const Argument_t& a) {
+    if (a.type == BOOL) {
+        // All BOOL args get added with false as default
+        parsed_args_[a.key].type = BOOL;
+        parsed_args_[a.key].value = false;
+        return false;
+    }
+    if (a.defaultval.type != UNK) {
+        // Non-BOOL args with explicit defaults
+        parsed_args_[a.key].type = a.type;
+        parsed_args_[a.key] = a.defaultval;
+        return true;
+    }
+
+    // Non-BOOL args without defaults - initialize based on nargs
+    parsed_args_[a.key].type = a.type;
+    
+    // If nargs is specified and not "1", initialize as vector
+    if (!a.nargs.empty() && a.nargs != "1") {
+        switch(a.type) {
+            case INT:
+                parsed_args_[a.key].value = std::vector<int>();
+                break;
+            case FLOAT:
+                parsed_args_[a.key].value = std::vector<float>();
+                break;
+            case STR:
+            case PATH:
+            case BLOB:
+                parsed_args_[a.key].value = std::vector<std::string>();
+                break;
+            default:
+                break;
+        }
+    } else {
+        // Single value initialization
+        switch(a.type) {
+            case INT:
+                parsed_args_[a.key].value = 0;
+                break;
+            case FLOAT:
+                parsed_args_[a.key].value = 0.0f;
+                break;
+            case STR:
+            case PATH:
+            case BLOB:
+                parsed_args_[a.key].value = std::string("");
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+
+ARGPARSE_INLINE int ArgumentParser::parse_args(int argc, char **argv) {
+    std::vector<std::string> args(argv, argv + argc);
+    return parse_args(args);
+}
+
+ARGPARSE_INLINE void ArgumentParser::add_command(const std::string& name, ArgumentParser& parser) {
+    if (name.empty() || name[0] == '-') {
+        throw ArgParseException("Invalid command name: " + name);
+    }
+    if (!impl_->commands_.emplace(name, &parser).second) {
+        throw ArgParseException("Duplicate command: " + name);
+    }
+    if (parser.impl_->prog_name_.empty()) {
+        parser.impl_->prog_name_ = name;
+    }
+}
+
+ARGPARSE_INLINE int ArgumentParser::parse_chain(const std::vector<std::string>& args, std::vector<CommandResult_t>& results, const std::string& delimiter) {
+    results.clear();
+
+    // One scan: find where the top-level options end and each stage starts.
+    // Option values are skipped, so a value may equal a command or the delimiter.
+    size_t first = 1;
+    std::vector<std::pair<size_t, size_t>> stages;     // [begin, end) token ranges
+    try {
+        while (first < args.size() && impl_->commands_.find(args[first]) == impl_->commands_.end()) {
+            first += 1 + option_span(args, first, delimiter);
+        }
+        first = std::min(first, args.size());
+        for (size_t begin = first; begin < args.size();) {
+            auto cmd = impl_->commands_.find(args[begin]);
+            size_t end = begin;
+            while (end < args.size() && args[end] != delimiter) {
+                end += end > begin && cmd != impl_->commands_.end() ? 1 + cmd->second->option_span(args, end, delimiter) : 1;
+            }
+            end = std::min(end, args.size());
+            stages.emplace_back(begin, end);
+            begin = end + 1;
+            if (end + 1 == args.size()) {
+                stages.emplace_back(args.size(), args.size());     // trailing delimiter
+            }
+        }
+    }
+    catch (const ArgParseException& e) {
+        error_output().write(std::string("Argument parsing error: ") + e.what() + "\n");
+        return -1;
+    }
+    results.reserve(stages.size() + 1);
+
+    // Top-level options
+    std::vector<std::string> segment(args.begin(), args.begin() + first);
+    int result = parse_args(segment);
+    if (result != 0) {
+        return result;
+    }
+    results.push_back(take_result());
+
+    for (const auto& stage : stages) {
+        auto cmd = stage.first < stage.second ? impl_->commands_.find(args[stage.first]) : impl_->commands_.end();
+        if (cmd == impl_->commands_.end()) {
+            std::string what = stage.first < stage.second ? "Unknown command: " + args[stage.first]
+                                                           : "Empty command after '" + delimiter + "'";
+            error_output().write("Argument parsing error: " + what + "\n");
+            results.clear();
+            return -1;
+        }
+        // Command name stands in for the program name of the sub-parser
+        segment.assign(args.begin() + stage.first, args.begin() + stage.second);
+        ArgumentParser& sub = *cmd->second;
+        result = sub.parse_args(segment);
+        if (result != 0) {
+            results.clear();
+            return result;
+        }
+        results.push_back(sub.take_result());
+        results.back().command = cmd->first;
+    }
+    return 0;
+}
+
+ARGPARSE_INLINE size_t ArgumentParser::option_span(const std::vector<std::string>& args, size_t i,
+                                                   const std::string& delimiter) {
+    const std::string& arg = args[i];
+    if (arg.empty() || arg[0] != '-' || detail::is_negative_number(arg)) {
+        return 0;
+    }
+    auto alias_it = impl_->alias_index_.find(arg);
+    if (alias_it == impl_->alias_index_.end()) {
+        auto lazy_it = impl_->lazy_alias_index_.find(arg);
+        if (lazy_it == impl_->lazy_alias_index_.end()) {
+            return 0;
+        }
+        load_group(lazy_it->second);
+        alias_it = impl_->alias_index_.find(arg);
+    }
+    const Argument_t& a = impl_->arg_list_[alias_it->second];
+    if (a.type == BOOL) {
+        return 0;
+    }
+    size_t lo, hi;
+    detail::nargs_bounds(a.nargs, lo, hi);
+    if (lo == hi) {
+        return lo;      // Fixed count: values are taken whatever they look like
+    }
+    size_t count = 0;
+    while (count < hi && detail::is_list_value(args, i + 1 + count) && args[i + 1 + count] != delimiter &&
+           impl_->commands_.find(args[i + 1 + count]) == impl_->commands_.end()) {
+        count++;
+    }
+    return count;
+}
+
+ARGPARSE_INLINE CommandResult_t ArgumentParser::take_result() {
+    CommandResult_t result{"", std::move(parsed_args_), std::move(parsed_pos_args_)};
+    parsed_args_.clear();
+    parsed_pos_args_.clear();
+    return result;
+}
 
-        // Parse args
-        if (!args_.empty())
-            args_.erase(args_.begin()); // remove program name
+ARGPARSE_INLINE int ArgumentParser::parse_command_line(std::string_view line) {
+    std::vector<std::string> args = {impl_->prog_name_};
+    try {
+        std::vector<std::string> tokens = split_command_line(line);
+        args.insert(args.end(), std::make_move_iterator(tokens.begin()), std::make_move_iterator(tokens.end()));
+    }
+    catch (const ArgParseException& e) {
+        error_output().write(std::string("Argument parsing error: ") + e.what() + "\n");
+        return -1;
+    }
+    return parse_args(args);
+}
+
+ARGPARSE_INLINE void ArgumentParser::reset_parsed() {
+    // Keep the map nodes (and their key strings) for the next parse
+    for (auto& entry : parsed_args_) {
+        entry.second.type = UNK;
+    }
+    parsed_pos_args_.clear();
+    impl_->arrays_.clear();
+    impl_->file_lists_.clear();
+}
+
+ARGPARSE_INLINE void ArgumentParser::drop_unset() {
+    for (auto it = parsed_args_.begin(); it != parsed_args_.end();) {
+        it = it->second.type == UNK ? parsed_args_.erase(it) : std::next(it);
+    }
+}
+
+ARGPARSE_INLINE int ArgumentParser::parse_args(const std::vector<std::string>& args, CommandResult_t& result) {
+    // The parser fills the result's storage and keeps the previous one for next time
+    parsed_args_.swap(result.args);
+    parsed_pos_args_.swap(result.pos_args);
+    int status = parse_args(args);
+    parsed_args_.swap(result.args);
+    parsed_pos_args_.swap(result.pos_args);
+    return status;
+}
+
+ARGPARSE_INLINE int ArgumentParser::parse_args(const std::vector<std::string>& args) {
+    // TODO: Need to check alias collisions
 
-        // Check for help first, before any parsing
-        for (const auto& arg : args_) {
+    reset_parsed();
+
+    try {
+        // Take program name from args if not set
+        if (impl_->prog_name_.size() == 0 && !args.empty()) {
+            impl_->prog_name_ = args[0];
+        }
+
+        // Fast path: help and early-exit flags are handled before any default
+        // is materialized or argv is copied. Scanning stops at "--".
+        for (size_t j = 1; j < args.size() && args[j] != "--"; j++) {
+            const std::string& arg = args[j];
+            if (arg.size() < 2 || arg[0] != '-') continue;
             if (arg == "-h" || arg == "--help") {
                 parsed_args_["help"].type = BOOL;
                 parsed_args_["help"].value = true;
+                drop_unset();
                 print_help();
                 return 1;
             }
+            if (arg.compare(0, 7, "--help=") == 0) {
+                parsed_args_["help"].type = BOOL;
+                parsed_args_["help"].value = true;
+                drop_unset();
+                print_help(arg.substr(7));
+                return 1;
+            }
+            if (arg.compare(0, 15, "--help-section=") == 0) {
+                parsed_args_["help"].type = BOOL;
+                parsed_args_["help"].value = true;
+                drop_unset();
+                print_help_section(arg.substr(15));
+                return 1;
+            }
+            auto it = impl_->alias_index_.find(arg);
+            if (it != impl_->alias_index_.end() && impl_->arg_list_[it->second].early_exit) {
+                const Argument_t& a = impl_->arg_list_[it->second];
+                parsed_args_[a.key] = {BOOL, true};
+                if (a.action && a.action(parsed_args_[a.key]) == ACTION_STOP) {
+                    drop_unset();
+                    return 1;
+                }
+            }
         }
 
-        // Sequential parsing like Python's argparse
-        std::vector<std::string> positional_values;
+        // Copy input args without the program name
+        impl_->args_.assign(args.empty() ? args.end() : args.begin() + 1, args.end());
+
+        // Track which arguments were provided (not just initialized), by index
+        impl_->provided_.assign(impl_->arg_list_.size(), 0);
         
+        // add bool args and set default values
+        for (size_t k = 0; k < impl_->arg_list_.size(); k++) {
+            if (init_default(impl_->arg_list_[k])) {
+                impl_->provided_[k] = 1;  // Defaults count as provided
+            }
+        }
+        drop_unset();   // Entries of the previous parse that no argument set
+
+        // Sequential parsing like Python's argparse; positional tokens
+        // collect in parsed_pos_args_ (reused capacity)
+        bool options_done = false;     // set by "--": everything after is positional
         size_t i = 0;
-        while(i < args_.size()) {
-            auto arg = args_[i];
+        while(i < impl_->args_.size()) {
+            const std::string& arg = impl_->args_[i];
             i++;
 
+            if (!options_done && arg == "--") {
+                options_done = true;
+                continue;
+            }
+
             // Check if this is an optional argument (starts with - but not a negative number)
-            if (arg[0] == '-' && !is_negative_number(arg)) {
+            if (!options_done && !arg.empty() && arg[0] == '-' && !detail::is_negative_number(arg)) {
                 // Find matching optional argument
-                bool found = false;
-                Argument_t *argp = nullptr;
-                
-                for (auto &a: arg_list_) {
-                    if (a.is_positional) continue;  // Skip positional arguments
-                    for (auto alias: a.aliases) {
-                        if (alias == arg) {
-                            found = true;
-                            argp = &a;
-                            break;
+                auto alias_it = impl_->alias_index_.find(arg);
+                if (alias_it == impl_->alias_index_.end()) {
+                    // Option of a lazy group: register the group and initialize its arguments
+                    auto lazy_it = impl_->lazy_alias_index_.find(arg);
+                    if (lazy_it != impl_->lazy_alias_index_.end()) {
+                        size_t first = impl_->arg_list_.size();
+                        load_group(lazy_it->second);
+                        impl_->provided_.resize(impl_->arg_list_.size(), 0);
+                        for (size_t k = first; k < impl_->arg_list_.size(); k++) {
+                            if (init_default(impl_->arg_list_[k])) {
+                                impl_->provided_[k] = 1;
+                            }
                         }
+                        alias_it = impl_->alias_index_.find(arg);
                     }
-                    if (found) break;
                 }
-
-                if (!found) {
+                if (alias_it == impl_->alias_index_.end()) {
                     throw ArgParseException("Unknown argument: " + arg);
                 }
+                Argument_t *argp = &impl_->arg_list_[alias_it->second];
+                impl_->provided_[alias_it->second] = 1;
 
                 // Handle optional argument
                 if (argp->type == BOOL) {
                     parsed_args_[argp->key].type = BOOL;
                     parsed_args_[argp->key].value = true;
-                    provided_args.insert(argp->key);
                 }
                 else {
                     // Parse values based on nargs
-                    std::vector<std::string> values = parse_nargs_values(args_, i, argp->nargs, arg);
+                    ArrayView<std::string> values = detail::parse_nargs_values(impl_->args_, i, argp->nargs, arg);
                     
                     // For single values (default nargs), store as single value
                     if (argp->nargs.empty() || argp->nargs == "1") {
                         if (values.size() != 1) {
                             throw ArgParseException("Expected exactly one value for argument: " + arg);
                         }
-                        const std::string& value = values[0];
-                        
-                        parsed_args_[argp->key].type = argp->type;
-                        switch(argp->type) {
-                            case INT:
-                                if (!is_valid_type(value, INT)) {
-                                    throw ArgParseException("Invalid integer value for " + arg + ": " + value);
-                                }
-                                parsed_args_[argp->key].value = std::stoi(value);
-                                break;
-                            case FLOAT:
-                                if (!is_valid_type(value, FLOAT)) {
-                                    throw ArgParseException("Invalid float value for " + arg + ": " + value);
-                                }
-                                parsed_args_[argp->key].value = strtof(value.c_str(), nullptr);
-                                break;
-                            case STR:
-                                parsed_args_[argp->key].value = value;
-                                break;
-                            default:
-                                throw ArgParseException("Unknown argument type for " + arg);
-                        }
-                        
-                        // Validate choices
-                        if (!is_valid_choice(value, argp->choices)) {
-                            std::string choices_str = "";
-                            for (size_t j = 0; j < argp->choices.size(); j++) {
-                                if (j > 0) choices_str += ", ";
-                                choices_str += "'" + argp->choices[j] + "'";
-                            }
-                            throw ArgParseException("Invalid choice for " + arg + ": '" + value + "' (choose from " + choices_str + ")");
-                        }
+                        parsed_args_[argp->key] = detail::convert_arg(*argp, values[0], arg);
                     } else {
                         // For multiple values, store as vector
-                        switch(argp->type) {
-                            case INT: {
-                                std::vector<int> int_values;
-                                for (const auto& value : values) {
-                                    if (!is_valid_type(value, INT)) {
-                                        throw ArgParseException("Invalid integer value for " + arg + ": " + value);
-                                    }
-                                    if (!is_valid_choice(value, argp->choices)) {
-                                        std::string choices_str = "";
-                                        for (size_t j = 0; j < argp->choices.size(); j++) {
-                                            if (j > 0) choices_str += ", ";
-                                            choices_str += "'" + argp->choices[j] + "'";
-                                        }
-                                        throw ArgParseException("Invalid choice for " + arg + ": '" + value + "' (choose from " + choices_str + ")");
-                                    }
-                                    int_values.push_back(std::stoi(value));
-                                }
-                                parsed_args_[argp->key].type = argp->type;
-                                parsed_args_[argp->key].value = int_values;
-                                break;
-                            }
-                            case FLOAT: {
-                                std::vector<float> float_values;
-                                for (const auto& value : values) {
-                                    if (!is_valid_type(value, FLOAT)) {
-                                        throw ArgParseException("Invalid float value for " + arg + ": " + value);
-                                    }
-                                    if (!is_valid_choice(value, argp->choices)) {
-                                        std::string choices_str = "";
-                                        for (size_t j = 0; j < argp->choices.size(); j++) {
-                                            if (j > 0) choices_str += ", ";
-                                            choices_str += "'" + argp->choices[j] + "'";
-                                        }
-                                        throw ArgParseException("Invalid choice for " + arg + ": '" + value + "' (choose from " + choices_str + ")");
-                                    }
-                                    float_values.push_back(strtof(value.c_str(), nullptr));
-                                }
-                                parsed_args_[argp->key].type = argp->type;
-                                parsed_args_[argp->key].value = float_values;
-                                break;
-                            }
-                            case STR: {
-                                std::vector<std::string> str_values;
-                                for (const auto& value : values) {
-                                    if (!is_valid_choice(value, argp->choices)) {
-                                        std::string choices_str = "";
-                                        for (size_t j = 0; j < argp->choices.size(); j++) {
-                                            if (j > 0) choices_str += ", ";
-                                            choices_str += "'" + argp->choices[j] + "'";
-                                        }
-                                        throw ArgParseException("Invalid choice for " + arg + ": '" + value + "' (choose from " + choices_str + ")");
-                                    }
-                                    str_values.push_back(value);
-                                }
-                                parsed_args_[argp->key].type = argp->type;
-                                parsed_args_[argp->key].value = str_values;
-                                break;
-                            }
-                            default:
-                                throw ArgParseException("Unknown argument type for " + arg);
+                        std::vector<std::string> expanded;
+                        if (argp->glob) {
+                            expanded = detail::expand_globs(values, argp->glob_max, arg);
+                            values = ArrayView<std::string>(nullptr, expanded.data(), expanded.size());
                         }
+                        unsigned threads = detail::conversion_threads(values.size(), impl_->parallel_min_, impl_->parallel_threads_);
+                        parsed_args_[argp->key] = detail::convert_arg_list(*argp, values, arg, threads);
                     }
-                    
-                    // Mark as provided
-                    provided_args.insert(argp->key);
+
+                }
+
+                // Inline action: may end parsing before the rest of argv is read
+                if (argp->action && !argp->early_exit && argp->action(parsed_args_[argp->key]) == ACTION_STOP) {
+                    return 1;
                 }
             } else {
                 // This is a positional argument
-                positional_values.push_back(arg);
-                parsed_pos_args_.push_back(arg);  // For backward compatibility
+                parsed_pos_args_.push_back(arg);
             }
         }
         
-        // Assign positional arguments to their defined parameters
-        for (size_t pos_idx = 0; pos_idx < pos_arg_list_.size(); pos_idx++) {
-            const auto& pos_arg = pos_arg_list_[pos_idx];
-            if (pos_idx < positional_values.size()) {
-                // Assign the positional value
-                const std::string& value = positional_values[pos_idx];
-                parsed_args_[pos_arg.key].type = pos_arg.type;
-                
-                switch(pos_arg.type) {
-                    case INT:
-                        if (!is_valid_type(value, INT)) {
-                            throw ArgParseException("Invalid integer value for " + pos_arg.key + ": " + value);
-                        }
-                        parsed_args_[pos_arg.key].value = std::stoi(value);
-                        break;
-                    case FLOAT:
-                        if (!is_valid_type(value, FLOAT)) {
-                            throw ArgParseException("Invalid float value for " + pos_arg.key + ": " + value);
-                        }
-                        parsed_args_[pos_arg.key].value = strtof(value.c_str(), nullptr);
-                        break;
-                    case STR:
-                        parsed_args_[pos_arg.key].value = value;
-                        break;
-                    case BOOL:
-                        if (!is_valid_type(value, BOOL)) {
-                            throw ArgParseException("Invalid boolean value for " + pos_arg.key + ": " + value);
-                        }
-                        parsed_args_[pos_arg.key].value = (value == "true" || value == "1");
-                        break;
-                    default:
-                        throw ArgParseException("Unknown argument type for " + pos_arg.key);
+        // Assign positional tokens to positional arguments in one left-to-right
+        // pass: each takes as many tokens as its nargs allows while leaving
+        // enough for the nargs minimums of all positionals after it
+        // (need_after, a running suffix sum), as Python's argparse does. If
+        // the tokens cannot cover every minimum, positionals take only their
+        // minimum in order; the ones left without tokens keep their default
+        // unless required.
+        size_t need_after = 0;
+        for (size_t idx : impl_->pos_arg_list_) {
+            size_t lo, hi;
+            detail::nargs_bounds(impl_->arg_list_[idx].nargs, lo, hi);
+            need_after += lo;
+        }
+        const bool short_of_minimums = parsed_pos_args_.size() < need_after;
+        size_t offset = 0;
+        for (size_t pos_idx = 0; pos_idx < impl_->pos_arg_list_.size(); pos_idx++) {
+            const auto& pos_arg = impl_->arg_list_[impl_->pos_arg_list_[pos_idx]];
+            const bool single = pos_arg.nargs.empty() || pos_arg.nargs == "1";
+            size_t lo, hi;
+            detail::nargs_bounds(pos_arg.nargs, lo, hi);
+            need_after -= lo;
+            size_t avail = parsed_pos_args_.size() - offset;
+            size_t take = short_of_minimums ? std::min(lo, avail) : std::min(hi, avail - need_after);
+            if (take == 0 && lo > 0) {
+                if (pos_arg.required) {
+                    throw ArgParseException("Missing required positional argument: " + pos_arg.key);
                 }
-                
-                // Mark positional argument as provided
-                provided_args.insert(pos_arg.key);
-                
-                // Validate choices for positional arguments
-                if (!is_valid_choice(value, pos_arg.choices)) {
-                    std::string choices_str = "";
-                    for (size_t j = 0; j < pos_arg.choices.size(); j++) {
-                        if (j > 0) choices_str += ", ";
-                        choices_str += "'" + pos_arg.choices[j] + "'";
-                    }
-                    throw ArgParseException("Invalid choice for " + pos_arg.key + ": '" + value + "' (choose from " + choices_str + ")");
+                continue;
+            }
+            if (take < lo) {
+                throw ArgParseException("Not enough values for argument " + pos_arg.key + " (expected " + pos_arg.nargs + ")");
+            }
+            if (take == 0) {
+                // "?" or "*" without tokens: satisfied, keeps its default
+            } else if (single) {
+                parsed_args_[pos_arg.key] = detail::convert_arg(pos_arg, parsed_pos_args_[offset], pos_arg.key);
+            } else {
+                ArrayView<std::string> values(nullptr, parsed_pos_args_.data() + offset, take);
+                std::vector<std::string> expanded;
+                if (pos_arg.glob) {
+                    expanded = detail::expand_globs(values, pos_arg.glob_max, pos_arg.key);
+                    values = ArrayView<std::string>(nullptr, expanded.data(), expanded.size());
                 }
-            } else if (pos_arg.required) {
-                throw ArgParseException("Missing required positional argument: " + pos_arg.key);
+                unsigned threads = detail::conversion_threads(values.size(), impl_->parallel_min_, impl_->parallel_threads_);
+                parsed_args_[pos_arg.key] = detail::convert_arg_list(pos_arg, values, pos_arg.key, threads);
             }
+            impl_->provided_[impl_->pos_arg_list_[pos_idx]] = 1;
+            offset += take;
         }
 
+        // Map binary array files (header and length checks only)
+        load_arrays();
+
+        // Read --files-from style lists
+        load_file_lists();
+
         // Help is handled earlier in parsing
 
         // Check for required arguments
-        for (const auto &a: arg_list_) {
-            if (a.required && provided_args.find(a.key) == provided_args.end()) {
-                throw ArgParseException("Required argument missing: " + a.key);
+        for (size_t k = 0; k < impl_->arg_list_.size(); k++) {
+            if (impl_->arg_list_[k].required && !impl_->provided_[k]) {
+                throw ArgParseException("Required argument missing: " + impl_->arg_list_[k].key);
             }
         }
 
         return 0;
     }
     catch (const ArgParseException& e) {
-        std::cerr << "Argument parsing error: " << e.what() << std::endl;
+        drop_unset();
+        error_output().write(std::string("Argument parsing error: ") + e.what() + "\n");
         return -1;
     }
 }
 
-void ArgumentParser::print_args() const {
-    printf("Args:\n");
+ARGPARSE_INLINE FileView ArgumentParser::get_file(const std::string& key) const {
+    auto it = parsed_args_.find(key);
+    if (it == parsed_args_.end()) {
+        throw std::runtime_error("Argument key '" + key + "' not found. Make sure you defined it with add_argument().");
+    }
+    const std::string* value = std::get_if<std::string>(&it->second.value);
+    if (!value) {
+        throw std::runtime_error("Argument '" + key + "' does not hold a single string value");
+    }
+    FileView view;
+    if (detail::file_reference(*value, view.path_)) {
+        view.file_ = std::make_shared<MappedFile>(view.path_);
+    } else {
+        view.inline_ = *value;
+    }
+    return view;
+}
+
+ARGPARSE_INLINE std::vector<unsigned char> ArgumentParser::get_blob(const std::string& key) const {
+    FileView view = get_file(key);
+    if (view.is_file()) {
+        return std::vector<unsigned char>(view.data(), view.data() + view.size());
+    }
+    const std::string& value = get<std::string>(key);
+    if (value.empty()) {
+        return {};
+    }
+    if (!detail::is_valid_blob(value)) {
+        throw ArgParseException("Invalid blob value for " + key + ": " + value);
+    }
+    return detail::decode_blob(value);
+}
+
+ARGPARSE_INLINE std::vector<std::string> ArgumentParser::complete(std::string_view line) const {
+    // Split off the word being completed; a trailing blank starts a new word
+    std::vector<std::string> words;
+    CommandTokenizer tokenizer;
+    try {
+        tokenizer.feed(line, words);
+        tokenizer.finish(words);
+    } catch (const ArgParseException&) {
+        return {};
+    }
+    std::string prefix;
+    if (!words.empty() && !line.empty() && line.back() != ' ' && line.back() != '\t') {
+        prefix = words.back();
+        words.pop_back();
+    }
+
+    std::vector<std::string> candidates;
+    if (!words.empty()) {
+        auto it = impl_->alias_index_.find(words.back());
+        if (it != impl_->alias_index_.end() && !impl_->arg_list_[it->second].choices.empty()) {
+            for (const auto& choice : impl_->arg_list_[it->second].choices) {
+                if (choice.compare(0, prefix.size(), prefix) == 0) {
+                    candidates.push_back(choice);
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+            return candidates;
+        }
+    }
+    if (prefix.empty() || prefix[0] == '-') {
+        for (auto it = impl_->alias_index_.lower_bound(prefix);
+             it != impl_->alias_index_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            candidates.push_back(it->first);
+        }
+        for (auto it = impl_->lazy_alias_index_.lower_bound(prefix);
+             it != impl_->lazy_alias_index_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            candidates.push_back(it->first);
+        }
+        std::sort(candidates.begin(), candidates.end());
+    }
+    return candidates;
+}
+
+ARGPARSE_INLINE void ArgumentParser::print_args() const {
+    std::string out = "Args:\n";
     for (const auto &k: parsed_args_){
-        printf("  %s: ", k.first.c_str());
+        out += "  " + k.first + ": ";
         switch (k.second.type)
         {
-            case BOOL:  printf("<bool> %s\n", std::get<bool>(k.second.value) ? "true": "false"); break;
-            case INT:   printf("<int> %d\n", std::get<int>(k.second.value)); break;
-            case FLOAT: printf("<float> %f\n", std::get<float>(k.second.value)); break;
-            case STR:   printf("<str> %s\n", std::get<std::string>(k.second.value).c_str()); break;
+            case BOOL:  out += std::string("<bool> ") + (std::get<bool>(k.second.value) ? "true": "false"); break;
+            case INT:   out += "<int> " + std::to_string(std::get<int>(k.second.value)); break;
+            case FLOAT: out += "<float> " + std::to_string(std::get<float>(k.second.value)); break;
+            case STR:   out += "<str> " + std::get<std::string>(k.second.value); break;
+            case PATH:  out += "<path> " + std::get<std::string>(k.second.value); break;
+            case BLOB:  out += "<blob> " + std::get<std::string>(k.second.value); break;
         default:
-            printf("<unk> ??\n"); break;
+            out += "<unk> ??"; break;
         }
+        out += "\n";
     }
 
-    printf("\nPositional Args: [");
+    out += "\nPositional Args: [";
     for (const auto& k: parsed_pos_args_){
-        printf("'%s' ", k.c_str());
+        out += "'" + k + "' ";
     }
-    printf("]\n");
+    out += "]\n";
+    output().write(out);
 }
 
+ARGPARSE_INLINE OutputSink& ArgumentParser::output() const {
+    static FdSink stdout_sink(1);
+    return out_ ? *out_ : stdout_sink;
+}
 
-void ArgumentParser::print_help() const {
-    printf("Usage: %s [options] [args]\n", prog_name_.c_str());
+ARGPARSE_INLINE OutputSink& ArgumentParser::error_output() const {
+    static FdSink stderr_sink(2);
+    return err_ ? *err_ : stderr_sink;
+}
 
-    if(description_.size() > 0)
-        printf("Description: %s\n", description_.c_str());
+ARGPARSE_INLINE ResultPool& ResultPool::local() {
+    static thread_local ResultPool pool;
+    return pool;
+}
 
-    printf("\nOptions:\n");
-    for (const auto& a: arg_list_){
-        if (a.is_positional) continue;  // Skip positional args in options section
-        
-        printf("  ");
-        for(size_t i=0; i<a.aliases.size(); i++) {
-            printf("%s", a.aliases[i].c_str());
+ARGPARSE_INLINE ResultPool::Handle ResultPool::acquire() {
+    std::unique_ptr<CommandResult_t> result;
+    stats_.acquired++;
+    if (!free_.empty()) {
+        result = std::move(free_.back());
+        free_.pop_back();
+        stats_.hits++;
+    } else {
+        result = std::make_unique<CommandResult_t>();
+    }
+    stats_.in_use++;
+    stats_.high_water = std::max(stats_.high_water, stats_.in_use);
+    return Handle(this, std::move(result));
+}
+
+ARGPARSE_INLINE void ResultPool::release(std::unique_ptr<CommandResult_t> result) {
+    if (!result) {
+        return;
+    }
+    if (stats_.in_use > 0) {
+        stats_.in_use--;
+    }
+    if (free_.size() >= max_free_) {
+        return;
+    }
+    result->command.clear();
+    result->pos_args.clear();
+    for (auto& entry : result->args) {
+        entry.second.type = UNK;
+    }
+    free_.push_back(std::move(result));
+}
+
+ARGPARSE_INLINE ResultPool::Stats ResultPool::stats() const {
+    Stats s = stats_;
+    s.free = free_.size();
+    return s;
+}
+
+// Destructors and writes out of line, so each sink's vtable and typeinfo
+// are emitted once in the library instead of in every including TU
+ARGPARSE_INLINE OutputSink::~OutputSink() = default;
+ARGPARSE_INLINE FdSink::~FdSink() = default;
+ARGPARSE_INLINE FileSink::~FileSink() = default;
+ARGPARSE_INLINE BufferSink::~BufferSink() = default;
+
+ARGPARSE_INLINE void FileSink::write(std::string_view text) {
+    fwrite(text.data(), 1, text.size(), file_);
+}
+
+ARGPARSE_INLINE void BufferSink::write(std::string_view text) {
+    buffer_.append(text.data(), text.size());
+}
+
+ARGPARSE_INLINE void FdSink::write(std::string_view text) {
+    // Retry short writes and EINTR; other errors drop the rest (nowhere to report them)
+    while (!text.empty()) {
+        ssize_t n = ::write(fd_, text.data(), text.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        text.remove_prefix((size_t)n);
+    }
+}
+
+
+ARGPARSE_INLINE void ArgumentParser::set_help_resource(const std::string& path) {
+    impl_->help_resource_ = std::make_shared<HelpResource_t>();
+    impl_->help_resource_->file = std::make_shared<MappedFile>(path);
+    impl_->help_entries_.clear();
+    impl_->help_index_.clear();
+}
+
+ARGPARSE_INLINE void ArgumentParser::set_help_resource(const char* data, size_t size) {
+    impl_->help_resource_ = std::make_shared<HelpResource_t>();
+    impl_->help_resource_->data = std::string_view(data, size);
+    impl_->help_entries_.clear();
+    impl_->help_index_.clear();
+}
+
+ARGPARSE_INLINE std::string_view ArgumentParser::resource_help(const std::string& key) const {
+    if (!impl_->help_resource_) {
+        return {};
+    }
+    HelpResource_t& res = *impl_->help_resource_;
+    if (!res.indexed) {
+        res.indexed = true;
+        if (res.file) {
+            try {
+                res.file->load();
+                res.data = std::string_view(res.file->data ? res.file->data : "", res.file->size);
+            } catch (const ArgParseException&) {
+                res.data = {};
+            }
+        }
+        // "key<TAB>text" per line; the views point into the resource itself
+        size_t pos = 0;
+        while (pos < res.data.size()) {
+            size_t eol = res.data.find('\n', pos);
+            if (eol == std::string_view::npos) eol = res.data.size();
+            std::string_view line = res.data.substr(pos, eol - pos);
+            pos = eol + 1;
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            size_t tab = line.find('\t');
+            if (line.empty() || line[0] == '#' || tab == std::string_view::npos) continue;
+            res.text.emplace(std::string(line.substr(0, tab)), line.substr(tab + 1));
+        }
+    }
+    auto it = res.text.find(key);
+    return it == res.text.end() ? std::string_view() : it->second;
+}
+
+// Render one argument's help block (cached until the spec changes)
+ARGPARSE_INLINE const std::string& ArgumentParser::help_entry(size_t idx) const {
+    if (impl_->help_entries_.size() != impl_->arg_list_.size()) {
+        impl_->help_entries_.assign(impl_->arg_list_.size(), std::string());
+    }
+    std::string& out = impl_->help_entries_[idx];
+    if (!out.empty()) {
+        return out;
+    }
+
+    const Argument_t& a = impl_->arg_list_[idx];
+    out += "  ";
+    if (a.is_positional) {
+        out += a.metavar.empty() ? a.key : a.metavar;
+    } else {
+        for (size_t i = 0; i < a.aliases.size(); i++) {
+            out += a.aliases[i];
             if (a.type != BOOL) {
                 // Show metavar or generate default
                 std::string meta = a.metavar;
@@ -689,49 +2257,209 @@ void ArgumentParser::print_help() const {
                         case INT: meta = "N"; break;
                         case FLOAT: meta = "F"; break;
                         case STR: meta = "STR"; break;
+                        case PATH: meta = "PATH"; break;
+                        case BLOB: meta = "BLOB"; break;
                         default: meta = "VALUE"; break;
                     }
                 }
-                printf(" %s", meta.c_str());
+                out += " " + meta;
             }
-            if (i < a.aliases.size() - 1) printf(", ");
+            if (i < a.aliases.size() - 1) out += ", ";
         }
-        printf("\n    %s\n", a.help.c_str());
-        
-        // Show choices if available
-        if (!a.choices.empty()) {
-            printf("    choices: {");
-            for (size_t i = 0; i < a.choices.size(); i++) {
-                printf("'%s'%s", a.choices[i].c_str(), (i < a.choices.size() - 1) ? ", " : "");
-            }
-            printf("}\n");
+    }
+    out += "\n    ";
+    if (a.help.empty()) {
+        out += resource_help(a.key);
+    } else {
+        out += a.help;
+    }
+    out += "\n";
+
+    // Show choices if available
+    if (!a.choices.empty()) {
+        out += "    choices: {";
+        for (size_t i = 0; i < a.choices.size(); i++) {
+            out += "'" + a.choices[i] + "'" + ((i < a.choices.size() - 1) ? ", " : "");
+        }
+        out += "}\n";
+    }
+
+    // Show numeric bounds if set
+    if (a.has_min || a.has_max) {
+        out += "    range: [" + (a.has_min ? detail::format_number(a.min_val) : "-inf") + ", " +
+               (a.has_max ? detail::format_number(a.max_val) : "inf") + "]";
+        if (a.step != 0) out += " step " + detail::format_number(a.step);
+        out += "\n";
+    }
+    if (a.pattern) {
+        out += "    pattern: " + a.pattern->source + "\n";
+    }
+    return out;
+}
+
+namespace detail {
+
+// Split text into lowercase alphanumeric words ("--dry-run" -> "dry", "run")
+inline std::vector<std::string> help_words(const std::string& text) {
+    std::vector<std::string> words;
+    std::string word;
+    for (char c : text) {
+        if (std::isalnum((unsigned char)c)) {
+            word += (char)std::tolower((unsigned char)c);
+        } else if (!word.empty()) {
+            words.push_back(word);
+            word.clear();
+        }
+    }
+    if (!word.empty()) words.push_back(word);
+    return words;
+}
+} // namespace detail
+
+// Word -> argument indices over aliases, keys and help text
+ARGPARSE_INLINE void ArgumentParser::build_help_index() const {
+    impl_->help_index_.clear();
+    for (size_t idx = 0; idx < impl_->arg_list_.size(); idx++) {
+        const Argument_t& a = impl_->arg_list_[idx];
+        std::string text = a.key + " " + a.help;
+        if (a.help.empty()) {
+            text += " ";
+            text += resource_help(a.key);
+        }
+        for (const auto& alias : a.aliases) {
+            text += " " + alias;
+        }
+        for (const auto& word : detail::help_words(text)) {
+            impl_->help_index_[word].push_back(idx);
+        }
+    }
+    for (auto& entry : impl_->help_index_) {
+        auto& v = entry.second;
+        v.erase(std::unique(v.begin(), v.end()), v.end());     // indices are appended in order
+    }
+}
+
+ARGPARSE_INLINE void ArgumentParser::print_help(const std::string& pattern) const {
+    if (impl_->help_index_.empty()) {
+        build_help_index();
+    }
+
+    // Every query word must prefix-match some indexed word of the argument
+    std::vector<size_t> matches;
+    bool first = true;
+    std::vector<std::string> query = detail::help_words(pattern);
+    for (const auto& word : query) {
+        std::vector<size_t> hits;
+        for (auto it = impl_->help_index_.lower_bound(word);
+             it != impl_->help_index_.end() && it->first.compare(0, word.size(), word) == 0; ++it) {
+            hits.insert(hits.end(), it->second.begin(), it->second.end());
+        }
+        std::sort(hits.begin(), hits.end());
+        hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+        if (first) {
+            matches = std::move(hits);
+            first = false;
+        } else {
+            std::vector<size_t> both;
+            std::set_intersection(matches.begin(), matches.end(), hits.begin(), hits.end(), std::back_inserter(both));
+            matches = std::move(both);
+        }
+    }
+    if (query.empty()) {
+        print_help();
+        return;
+    }
+
+    std::string out;
+    if (matches.empty()) {
+        out = "No options match '" + pattern + "'\n";
+    } else {
+        out = "Options matching '" + pattern + "':\n";
+        for (size_t idx : matches) {
+            out += help_entry(idx);
+        }
+    }
+    output().write(out);
+}
+
+ARGPARSE_INLINE std::string ArgumentParser::group_help(size_t idx) const {
+    const Group_t& g = impl_->groups_[idx];
+    std::string out = "\n" + g.name + ":\n";
+    if (!g.description.empty()) {
+        out += "  " + g.description + "\n";
+    }
+    if (g.registrar) {
+        // Not loaded: only the claimed aliases are known
+        out += "  ";
+        for (size_t i = 0; i < g.aliases.size(); i++) {
+            out += g.aliases[i] + (i < g.aliases.size() - 1 ? ", " : "");
+        }
+        out += "\n    see --help-section=" + g.name + "\n";
+        return out;
+    }
+    for (size_t a = 0; a < impl_->arg_list_.size(); a++) {
+        if (!impl_->arg_list_[a].is_positional && impl_->arg_list_[a].group == g.name) {
+            out += help_entry(a);
         }
     }
+    return out;
+}
+
+ARGPARSE_INLINE void ArgumentParser::print_help_section(const std::string& group) {
+    for (size_t idx = 0; idx < impl_->groups_.size(); idx++) {
+        if (impl_->groups_[idx].name == group) {
+            load_group(idx);
+            std::string out = group_help(idx).substr(1) + "\n";
+            output().write(out);
+            return;
+        }
+    }
+    throw ArgParseException("Unknown help section: " + group);
+}
+
+ARGPARSE_INLINE void ArgumentParser::print_help() const {
+    std::string out = "Usage: " + impl_->prog_name_ + " [options] [args]\n";
+
+    if(impl_->description_.size() > 0)
+        out += "Description: " + impl_->description_ + "\n";
+    else if (!resource_help(":description").empty())
+        out += "Description: " + std::string(resource_help(":description")) + "\n";
+
+    out += "\nOptions:\n";
+    for (size_t idx = 0; idx < impl_->arg_list_.size(); idx++) {
+        if (impl_->arg_list_[idx].is_positional) continue;  // Skip positional args in options section
+        if (!impl_->arg_list_[idx].group.empty()) continue; // Listed under their group
+        out += help_entry(idx);
+    }
+
+    // One section per argument group
+    for (size_t g = 0; g < impl_->groups_.size(); g++) {
+        out += group_help(g);
+    }
     
     // Show positional arguments
-    bool has_positional = false;
-    for (const auto& a: arg_list_) {
-        if (a.is_positional) {
-            if (!has_positional) {
-                printf("\nPositional arguments:\n");
-                has_positional = true;
-            }
-            std::string meta = a.metavar.empty() ? a.key : a.metavar;
-            printf("  %s\n    %s\n", meta.c_str(), a.help.c_str());
-            
-            // Show choices if available
-            if (!a.choices.empty()) {
-                printf("    choices: {");
-                for (size_t i = 0; i < a.choices.size(); i++) {
-                    printf("'%s'%s", a.choices[i].c_str(), (i < a.choices.size() - 1) ? ", " : "");
-                }
-                printf("}\n");
-            }
+    if (!impl_->pos_arg_list_.empty()) {
+        out += "\nPositional arguments:\n";
+        for (size_t idx : impl_->pos_arg_list_) {
+            out += help_entry(idx);
         }
     }
 
-    if(epilog_.size() > 0)
-        printf("%s\n", epilog_.c_str());
+    // Show chainable commands
+    if (!impl_->commands_.empty()) {
+        out += "\nCommands:\n";
+        for (const auto& c : impl_->commands_) {
+            out += "  " + c.first + "\n    " + c.second->impl_->description_ + "\n";
+        }
+    }
 
-    printf("\n");
+    if(impl_->epilog_.size() > 0)
+        out += impl_->epilog_ + "\n";
+    else if (!resource_help(":epilog").empty())
+        out += std::string(resource_help(":epilog")) + "\n";
+
+    out += "\n";
+    output().write(out);
 }
+
+} // namespace ArgParse
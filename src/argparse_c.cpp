@@ -0,0 +1,267 @@
+#include "argparse_c.h"
+#include "argparse.h"
+#include <new>
+
+using ArgParse::ArgumentParser;
+using ArgParse::ArgVal_t;
+using ArgParse::CommandResult_t;
+
+// argparse_type values are cast straight to ArgType_t
+static_assert(ARGPARSE_BOOL == (int)ArgParse::BOOL && ARGPARSE_INT == (int)ArgParse::INT &&
+              ARGPARSE_FLOAT == (int)ArgParse::FLOAT && ARGPARSE_STR == (int)ArgParse::STR &&
+              ARGPARSE_PATH == (int)ArgParse::PATH && ARGPARSE_BLOB == (int)ArgParse::BLOB,
+              "argparse_type must match ArgParse::ArgType_t");
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Handles
+
+struct argparse_spec {
+    ArgumentParser parser;
+    std::vector<std::string> keys;      // Argument key per slot
+    std::string error;                  // Message of the last failed call
+    ArgParse::BufferSink parse_errors;  // Parser diagnostics, moved into error
+
+    argparse_spec(const char* prog, const char* description):
+        parser(prog ? prog : "", description ? description : "")
+    {
+        parser.set_error_output(&parse_errors);
+    }
+};
+
+struct argparse_result {
+    CommandResult_t values;                     // Owns everything handed out as views
+    std::vector<const ArgVal_t*> slots;         // Slot -> value (null if the key has none)
+};
+
+// Value stored in a slot, or null
+static const ArgVal_t* slot_value(const argparse_result* result, int slot) {
+    if (!result || slot < 0 || (size_t)slot >= result->slots.size()) {
+        return nullptr;
+    }
+    return result->slots[slot];
+}
+
+// Pointer to the alternative T of a slot's value; sets status on failure
+template<typename T>
+static const T* slot_get(const argparse_result* result, int slot, int& status) {
+    const ArgVal_t* v = slot_value(result, slot);
+    if (!v) {
+        status = ARGPARSE_ERR_SLOT;
+        return nullptr;
+    }
+    const T* p = std::get_if<T>(&v->value);
+    status = p ? ARGPARSE_OK : ARGPARSE_ERR_TYPE;
+    return p;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Spec
+
+extern "C" int argparse_api_version(void) {
+    return ARGPARSE_C_API_VERSION;
+}
+
+extern "C" argparse_spec* argparse_spec_new(const char* prog, const char* description) {
+    try {
+        return new argparse_spec(prog, description);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" void argparse_spec_free(argparse_spec* spec) {
+    delete spec;
+}
+
+extern "C" int argparse_spec_add(argparse_spec* spec, const char* const* aliases, size_t n_aliases,
+                                 const char* help, argparse_type type, const char* default_value, int required,
+                                 const char* const* choices, size_t n_choices, const char* nargs) {
+    if (!spec) {
+        return -1;
+    }
+    spec->error.clear();
+    try {
+        if (!aliases || n_aliases == 0) {
+            throw ArgParse::ArgParseException("No aliases provided");
+        }
+        if (type < ARGPARSE_BOOL || type > ARGPARSE_BLOB) {
+            throw ArgParse::ArgParseException("Unknown argument type: " + std::to_string((int)type));
+        }
+        std::vector<std::string> names(aliases, aliases + n_aliases);
+        std::vector<std::string> allowed;
+        if (choices) {
+            allowed.assign(choices, choices + n_choices);
+        }
+
+        spec->keys.push_back(spec->parser.add_argument(names, help ? help : "", (ArgParse::ArgType_t)type,
+                                                       default_value ? default_value : "", required != 0, "",
+                                                       allowed, "", nargs ? nargs : ""));
+        return (int)spec->keys.size() - 1;
+    } catch (const std::exception& e) {
+        spec->error = e.what();
+        return -1;
+    }
+}
+
+extern "C" int argparse_spec_slot(const argparse_spec* spec, const char* key) {
+    if (!spec || !key) {
+        return -1;
+    }
+    for (size_t i = 0; i < spec->keys.size(); i++) {
+        if (spec->keys[i] == key) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+extern "C" const char* argparse_spec_error(const argparse_spec* spec) {
+    return spec ? spec->error.c_str() : "";
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Parsing
+
+extern "C" int argparse_parse(argparse_spec* spec, int argc, const char* const* argv, argparse_result** result) {
+    if (result) {
+        *result = nullptr;
+    }
+    if (!spec || !result || argc < 0 || (argc > 0 && !argv)) {
+        return -1;
+    }
+    spec->error.clear();
+    try {
+        std::vector<std::string> args(argv, argv + argc);
+        spec->parse_errors.clear();
+        int status = spec->parser.parse_args(args);
+        if (status != 0) {
+            if (status < 0) {
+                // "Argument parsing error: <what>\n" -> "<what>"
+                std::string msg = spec->parse_errors.str();
+                const std::string prefix = "Argument parsing error: ";
+                if (msg.compare(0, prefix.size(), prefix) == 0) msg.erase(0, prefix.size());
+                while (!msg.empty() && msg.back() == '\n') msg.pop_back();
+                spec->error = msg.empty() ? "Argument parsing failed" : msg;
+            }
+            return status;
+        }
+
+        // Values move into the result; slots are resolved once here, not per access
+        argparse_result* res = new argparse_result;
+        res->values = spec->parser.take_result();
+        res->slots.reserve(spec->keys.size());
+        for (const auto& key : spec->keys) {
+            auto it = res->values.args.find(key);
+            res->slots.push_back(it == res->values.args.end() ? nullptr : &it->second);
+        }
+        *result = res;
+        return 0;
+    } catch (const std::exception& e) {
+        spec->error = e.what();
+        return -1;
+    }
+}
+
+extern "C" void argparse_result_free(argparse_result* result) {
+    delete result;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Accessors
+
+extern "C" int argparse_get_bool(const argparse_result* result, int slot, int* value) {
+    int status;
+    const bool* p = slot_get<bool>(result, slot, status);
+    if (p && value) *value = *p ? 1 : 0;
+    return status;
+}
+
+extern "C" int argparse_get_int(const argparse_result* result, int slot, int* value) {
+    int status;
+    const int* p = slot_get<int>(result, slot, status);
+    if (p && value) *value = *p;
+    return status;
+}
+
+extern "C" int argparse_get_float(const argparse_result* result, int slot, float* value) {
+    int status;
+    const float* p = slot_get<float>(result, slot, status);
+    if (p && value) *value = *p;
+    return status;
+}
+
+extern "C" int argparse_get_str(const argparse_result* result, int slot, const char** data, size_t* len) {
+    int status;
+    const std::string* p = slot_get<std::string>(result, slot, status);
+    if (p) {
+        if (data) *data = p->c_str();
+        if (len) *len = p->size();
+    }
+    return status;
+}
+
+extern "C" size_t argparse_get_count(const argparse_result* result, int slot) {
+    const ArgVal_t* v = slot_value(result, slot);
+    if (!v) {
+        return 0;
+    }
+    if (auto p = std::get_if<std::vector<int>>(&v->value)) return p->size();
+    if (auto p = std::get_if<std::vector<float>>(&v->value)) return p->size();
+    if (auto p = std::get_if<std::vector<std::string>>(&v->value)) return p->size();
+    return 0;
+}
+
+extern "C" int argparse_get_int_list(const argparse_result* result, int slot, const int** data, size_t* count) {
+    int status;
+    const std::vector<int>* p = slot_get<std::vector<int>>(result, slot, status);
+    if (p) {
+        if (data) *data = p->data();
+        if (count) *count = p->size();
+    }
+    return status;
+}
+
+extern "C" int argparse_get_float_list(const argparse_result* result, int slot, const float** data, size_t* count) {
+    int status;
+    const std::vector<float>* p = slot_get<std::vector<float>>(result, slot, status);
+    if (p) {
+        if (data) *data = p->data();
+        if (count) *count = p->size();
+    }
+    return status;
+}
+
+extern "C" int argparse_get_str_at(const argparse_result* result, int slot, size_t index, const char** data, size_t* len) {
+    int status;
+    const std::vector<std::string>* p = slot_get<std::vector<std::string>>(result, slot, status);
+    if (!p) {
+        return status;
+    }
+    if (index >= p->size()) {
+        return ARGPARSE_ERR_RANGE;
+    }
+    if (data) *data = (*p)[index].c_str();
+    if (len) *len = (*p)[index].size();
+    return ARGPARSE_OK;
+}
+
+extern "C" size_t argparse_get_pos_count(const argparse_result* result) {
+    return result ? result->values.pos_args.size() : 0;
+}
+
+extern "C" int argparse_get_pos_at(const argparse_result* result, size_t index, const char** data, size_t* len) {
+    if (!result) {
+        return ARGPARSE_ERR_SLOT;
+    }
+    if (index >= result->values.pos_args.size()) {
+        return ARGPARSE_ERR_RANGE;
+    }
+    const std::string& s = result->values.pos_args[index];
+    if (data) *data = s.c_str();
+    if (len) *len = s.size();
+    return ARGPARSE_OK;
+}
@@ -0,0 +1,69 @@
+#include "argparse.h"
+#include <unistd.h>
+
+namespace ArgParse {
+
+////////////////////////////////////////////////////////////////////////////////
+// ArgumentRepl
+
+ARGPARSE_INLINE ArgumentRepl::ArgumentRepl(ArgumentParser& parser, Handler handler, const std::string& prompt):
+    parser_(parser),
+    handler_(std::move(handler)),
+    prompt_(prompt)
+{
+}
+
+ARGPARSE_INLINE int ArgumentRepl::execute(std::string_view line) {
+    // Keep the program-name slot and the buffer capacity from earlier lines
+    dispatched_ = false;
+    tokens_.resize(1);
+    try {
+        tokenizer_.feed(line, tokens_);
+        tokenizer_.finish(tokens_);
+    } catch (const ArgParseException& e) {
+        parser_.error_output().write(std::string("Argument parsing error: ") + e.what() + "\n");
+        return -1;
+    }
+    if (tokens_.size() == 1) {
+        return 0;   // blank line
+    }
+
+    int result = parser_.parse_args(tokens_);
+    if (result != 0) {
+        return result;
+    }
+    dispatched_ = true;
+    return handler_ ? handler_(parser_) : 0;
+}
+
+ARGPARSE_INLINE int ArgumentRepl::run(FILE* in) {
+    bool interactive = isatty(fileno(in));
+    std::string line;
+    char buf[4096];
+
+    while (true) {
+        if (interactive) {
+            parser_.output().write(prompt_);
+        }
+
+        // Read one full line, however long
+        line.clear();
+        bool got_input = false;
+        while (fgets(buf, sizeof(buf), in)) {
+            got_input = true;
+            line += buf;
+            if (!line.empty() && line.back() == '\n') break;
+        }
+        if (!got_input) {
+            return 0;   // end of input
+        }
+
+        // Parse errors and help don't end the session; handler results do
+        int result = execute(line);
+        if (dispatched_ && result != 0) {
+            return result;
+        }
+    }
+}
+
+} // namespace ArgParse
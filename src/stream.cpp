@@ -0,0 +1,79 @@
+#include "argparse.h"
+#include <cerrno>
+#include <unistd.h>
+
+namespace ArgParse {
+
+////////////////////////////////////////////////////////////////////////////////
+// StreamParser
+
+ARGPARSE_INLINE StreamParser::StreamParser(ArgumentParser& parser, Handler handler):
+    parser_(parser),
+    handler_(std::move(handler)),
+    tokens_(1)
+{
+}
+
+ARGPARSE_INLINE int StreamParser::dispatch() {
+    if (tokens_.size() == 1) {
+        return 0;   // blank line
+    }
+    commands_++;
+    int result = parser_.parse_args(tokens_);
+    tokens_.resize(1);      // keep the program-name slot and the buffer capacity
+    if (result != 0) {
+        if (result < 0) errors_++;
+        return 0;
+    }
+    return handler_ ? handler_(parser_) : 0;
+}
+
+ARGPARSE_INLINE int StreamParser::feed(std::string_view chunk) {
+    while (!stopped_ && !chunk.empty()) {
+        if (tokenizer_.feed_command(chunk, tokens_)) {
+            stopped_ = dispatch();
+        }
+    }
+    return stopped_;
+}
+
+ARGPARSE_INLINE int StreamParser::finish() {
+    if (stopped_) {
+        return stopped_;
+    }
+    try {
+        tokenizer_.finish(tokens_);
+    } catch (const ArgParseException& e) {
+        tokens_.resize(1);
+        errors_++;
+        parser_.error_output().write(std::string("Argument parsing error: ") + e.what() + "\n");
+        return -1;
+    }
+    stopped_ = dispatch();
+    return stopped_;
+}
+
+ARGPARSE_INLINE int StreamParser::run(int fd) {
+    char buf[65536];
+    while (true) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) {
+            return finish();
+        }
+        if (int result = feed(std::string_view(buf, (size_t)n))) {
+            return result;
+        }
+    }
+}
+
+ARGPARSE_INLINE void StreamParser::reset() {
+    tokenizer_.reset();
+    tokens_.resize(1);
+    stopped_ = 0;
+}
+
+} // namespace ArgParse
@@ -0,0 +1,177 @@
+#include "argparse.h"
+#include <cstring>
+
+namespace ArgParse {
+
+////////////////////////////////////////////////////////////////////////////////
+// Character classes
+
+namespace detail {
+
+enum CharClass_t : unsigned char {
+    ORDINARY,
+    BLANK,
+    SINGLE_QUOTE,
+    DOUBLE_QUOTE,
+    BACKSLASH
+};
+
+// Byte -> class lookup so runs of ordinary characters are scanned with a
+// single table load per byte and copied in one append
+struct CharClassTable {
+    unsigned char cls[256];
+    CharClassTable() {
+        for (int c = 0; c < 256; c++) cls[c] = ORDINARY;
+        cls[(unsigned char)' ']  = BLANK;
+        cls[(unsigned char)'\t'] = BLANK;
+        cls[(unsigned char)'\n'] = BLANK;
+        cls[(unsigned char)'\r'] = BLANK;
+        cls[(unsigned char)'\''] = SINGLE_QUOTE;
+        cls[(unsigned char)'"']  = DOUBLE_QUOTE;
+        cls[(unsigned char)'\\'] = BACKSLASH;
+    }
+};
+
+inline const CharClassTable char_table;
+
+inline unsigned char char_class(char c) {
+    return char_table.cls[(unsigned char)c];
+}
+
+} // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+// CommandTokenizer
+
+ARGPARSE_INLINE void CommandTokenizer::feed(std::string_view chunk, std::vector<std::string>& tokens) {
+    bool ended;
+    scan(chunk.data(), chunk.data() + chunk.size(), tokens, false, ended);
+}
+
+ARGPARSE_INLINE bool CommandTokenizer::feed_command(std::string_view& chunk, std::vector<std::string>& tokens) {
+    bool ended = false;
+    const char* stop = scan(chunk.data(), chunk.data() + chunk.size(), tokens, true, ended);
+    chunk.remove_prefix(stop - chunk.data());
+    return ended;
+}
+
+ARGPARSE_INLINE const char* CommandTokenizer::scan(const char* p, const char* end, std::vector<std::string>& tokens,
+                                                   bool stop_at_newline, bool& ended) {
+    ended = false;
+    while (p < end) {
+        switch (state_) {
+            case SPACE: {
+                while (p < end && detail::char_class(*p) == detail::BLANK) {
+                    if (stop_at_newline && *p == '\n') {
+                        ended = true;
+                        return p + 1;
+                    }
+                    p++;
+                }
+                if (p < end) state_ = WORD;
+                break;
+            }
+            case WORD: {
+                const char* run = p;
+                while (p < end && detail::char_class(*p) == detail::ORDINARY) p++;
+                if (p > run) {
+                    current_.append(run, p - run);
+                    started_ = true;
+                }
+                if (p == end) break;
+                switch (detail::char_class(*p++)) {
+                    case detail::BLANK:
+                        if (started_) {
+                            tokens.push_back(std::move(current_));
+                            current_.clear();
+                            started_ = false;
+                        }
+                        state_ = SPACE;
+                        if (stop_at_newline && p[-1] == '\n') {
+                            ended = true;
+                            return p;
+                        }
+                        break;
+                    case detail::SINGLE_QUOTE: state_ = SQUOTE; started_ = true; break;
+                    case detail::DOUBLE_QUOTE: state_ = DQUOTE; started_ = true; break;
+                    case detail::BACKSLASH:    state_ = ESCAPE; break;
+                    default: break;
+                }
+                break;
+            }
+            case SQUOTE: {
+                const char* q = static_cast<const char*>(memchr(p, '\'', end - p));
+                const char* stop = q ? q : end;
+                current_.append(p, stop - p);
+                p = stop;
+                if (q) {
+                    p++;
+                    state_ = WORD;
+                }
+                break;
+            }
+            case DQUOTE: {
+                const char* run = p;
+                while (p < end && *p != '"' && *p != '\\') p++;
+                current_.append(run, p - run);
+                if (p == end) break;
+                state_ = (*p++ == '"') ? WORD : DQUOTE_ESCAPE;
+                break;
+            }
+            case ESCAPE: {
+                char c = *p++;
+                if (c != '\n') {            // backslash-newline is a line continuation
+                    current_ += c;
+                    started_ = true;
+                }
+                state_ = WORD;
+                break;
+            }
+            case DQUOTE_ESCAPE: {
+                char c = *p++;
+                if (c == '"' || c == '\\' || c == '$' || c == '`') {
+                    current_ += c;
+                } else if (c != '\n') {
+                    current_ += '\\';
+                    current_ += c;
+                }
+                state_ = DQUOTE;
+                break;
+            }
+        }
+    }
+    return p;
+}
+
+ARGPARSE_INLINE void CommandTokenizer::finish(std::vector<std::string>& tokens) {
+    State_t state = state_;
+    if (state == SQUOTE || state == DQUOTE || state == DQUOTE_ESCAPE) {
+        reset();
+        throw ArgParseException("No closing quotation");
+    }
+    if (state == ESCAPE) {
+        reset();
+        throw ArgParseException("No escaped character");
+    }
+    if (started_) {
+        tokens.push_back(std::move(current_));
+    }
+    reset();
+}
+
+ARGPARSE_INLINE void CommandTokenizer::reset() {
+    state_ = SPACE;
+    current_.clear();
+    started_ = false;
+}
+
+ARGPARSE_INLINE std::vector<std::string> split_command_line(std::string_view line) {
+    std::vector<std::string> tokens;
+    CommandTokenizer tokenizer;
+    tokenizer.feed(line, tokens);
+    tokenizer.finish(tokens);
+    return tokens;
+}
+
+} // namespace ArgParse
@@ -22,6 +22,28 @@
  *   - Boundary value testing
  *   - Error message validation
  *   - Performance stress tests
+ *   - Range, step and predicate validators
+ *   - Regex-constrained string arguments
+ *   - PATH arguments with filesystem checks
+ *   - Glob expansion of list values
+ *   - File-content views and BLOB arguments
+ *   - Memory-mapped binary array arguments
+ *   - Shell-style command string tokenizing
+ *   - REPL helper and tab completion
+ *   - Chained sub-command parsing
+ *   - Inline action callbacks
+ *   - Help / early-exit fast path and "--" handling
+ *   - Searchable help (--help=<pattern>)
+ *   - Argument groups and lazy group registration
+ *   - Help text loaded from an external resource
+ *   - C interface (spec/result handles, slot accessors)
+ *   - Heap-free fixed-capacity parser
+ *   - Pluggable output sinks (help, errors, print_args)
+ *   - Parallel conversion of large nargs lists
+ *   - Thread-local result pools
+ *   - Incremental parsing from a byte stream
+ *   - --files-from lists (mapped file, stdin, visitor)
+ *   - Positional nargs intermixed with options
  */
 
 #include <iostream>
@@ -32,10 +54,55 @@
 #include <functional>
 #include <cmath>
 #include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <thread>
 #include "argparse.h"
+#include "argparse_c.h"
+#include "argparse_static.h"
+#include <atomic>
+#include <new>
+#include <cerrno>
+#include <dlfcn.h>
+#include <pthread.h>
 
 using namespace ArgParse;
 
+// Heap allocation counter, read by the heap-free StaticParser test
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+// GCC pairs the malloc above with operator new and warns about the free
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+// Threads that may still be created (-1 = no limit), for the tests of
+// processes where thread creation fails
+static std::atomic<int> g_thread_budget{-1};
+
+extern "C" int pthread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*start)(void*), void* arg) noexcept {
+    using create_fn = int (*)(pthread_t*, const pthread_attr_t*, void* (*)(void*), void*);
+    static create_fn real_create = (create_fn)dlsym(RTLD_NEXT, "pthread_create");
+    int budget = g_thread_budget.load();
+    while (budget > 0 && !g_thread_budget.compare_exchange_weak(budget, budget - 1)) {}
+    if (budget == 0) {
+        return EAGAIN;
+    }
+    return real_create(thread, attr, start, arg);
+}
+
 class UnifiedTestSuite {
 private:
     int total_tests = 0;
@@ -72,6 +139,27 @@ private:
         }
     }
 
+    // Run fn with stdout redirected and return what it printed
+    std::string capture_stdout(std::function<void()> fn) {
+        std::cout.flush();
+        fflush(stdout);
+        int saved = dup(1);
+        FILE* tmp = tmpfile();
+        dup2(fileno(tmp), 1);
+        fn();
+        std::cout.flush();
+        fflush(stdout);
+        dup2(saved, 1);
+        close(saved);
+        std::string out;
+        rewind(tmp);
+        char buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), tmp)) > 0) out.append(buf, n);
+        fclose(tmp);
+        return out;
+    }
+
 public:
     void test_basic_types() {
         print_test_header("Basic Argument Types");
@@ -781,6 +869,22 @@ public:
             return result == 0 && tags.empty();
         });
         
+        // Value spans end at the next option; negative numbers stay values
+        run_test("nargs spans stop at options and count exactly", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--xs"}, "Xs", INT, "", false, "", {}, "", "+");
+            parser.add_argument({"--pair"}, "Pair", INT, "", false, "", {}, "", "2");
+            parser.add_argument({"--opt"}, "Opt", STR, "", false, "", {}, "", "?");
+            parser.add_argument({"-v"}, "Verbose", BOOL);
+            std::vector<std::string> args = {"test", "--xs", "1", "-2", "3", "-v", "--pair", "-4", "5", "--opt"};
+            bool ok = parser.parse_args(args) == 0 && parser.get_list<int>("xs") == std::vector<int>{1, -2, 3} &&
+                      parser.get_list<int>("pair") == std::vector<int>{-4, 5} && parser.get<bool>("v") &&
+                      parser.get_list<std::string>("opt").empty();
+            std::vector<std::string> short_pair = {"test", "--pair", "1"};
+            std::vector<std::string> empty_plus = {"test", "--xs", "-v"};
+            return ok && parser.parse_args(short_pair) == -1 && parser.parse_args(empty_plus) == -1;
+        });
+        
         // Test nargs with large numbers
         run_test("nargs with large specific count", [&]() {
             ArgumentParser parser("test");
@@ -975,6 +1079,1700 @@ public:
         });
     }
     
+    void test_range_validators() {
+        print_test_header("Range and Predicate Validators");
+        
+        run_test("INT value inside range accepted", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--port"}, "Port", INT);
+            parser.set_range("port", 1, 65535);
+            
+            std::vector<std::string> args = {"test", "--port", "8080"};
+            return parser.parse_args(args) == 0 && parser.get<int>("port") == 8080;
+        });
+        
+        run_test("INT value outside range rejected", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--port"}, "Port", INT);
+            parser.set_range("port", 1, 65535);
+            
+            std::vector<std::string> args = {"test", "--port", "70000"};
+            return parser.parse_args(args) == -1;
+        });
+        
+        run_test("FLOAT bounds checked on every nargs element", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--ratios"}, "Ratios", FLOAT, "", false, "", {}, "", "+");
+            parser.set_range("ratios", 0.0, 1.0);
+            
+            std::vector<std::string> ok = {"test", "--ratios", "0", "0.5", "1"};
+            std::vector<std::string> bad = {"test", "--ratios", "0.5", "1.5"};
+            return parser.parse_args(ok) == 0 && parser.parse_args(bad) == -1;
+        });
+        
+        run_test("Step constraint and one-sided bounds", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--size"}, "Size", INT);
+            parser.add_argument({"--level"}, "Level", INT);
+            parser.set_range("size", 0, 1024, 64);
+            parser.set_min("level", 3);
+            
+            std::vector<std::string> ok = {"test", "--size", "128", "--level", "100"};
+            std::vector<std::string> bad_step = {"test", "--size", "100"};
+            std::vector<std::string> bad_min = {"test", "--level", "2"};
+            return parser.parse_args(ok) == 0 && parser.parse_args(bad_step) == -1 &&
+                   parser.parse_args(bad_min) == -1;
+        });
+        
+        run_test("FLOAT step accepted for large values", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--x"}, "X", FLOAT);
+            parser.set_range("x", 0, 100000, 0.1);
+            
+            std::vector<std::string> small = {"test", "--x", "1.1"};
+            std::vector<std::string> large = {"test", "--x", "1000.1"};
+            std::vector<std::string> larger = {"test", "--x", "12345.6"};
+            std::vector<std::string> bad = {"test", "--x", "12345.65"};
+            return parser.parse_args(small) == 0 && parser.parse_args(large) == 0 &&
+                   parser.parse_args(larger) == 0 && parser.parse_args(bad) == -1;
+        });
+        
+        run_test("Range on positional argument", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"count"}, "Count", INT, "", true);
+            parser.set_max("count", 10);
+            
+            std::vector<std::string> args = {"test", "11"};
+            return parser.parse_args(args) == -1;
+        });
+        
+        run_test("Custom predicate validator", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--name"}, "Name", STR);
+            parser.set_validator("name", [](const std::string& v) { return !v.empty() && v[0] != '_'; },
+                                 "must not start with '_'");
+            
+            std::vector<std::string> ok = {"test", "--name", "alice"};
+            std::vector<std::string> bad = {"test", "--name", "_hidden"};
+            return parser.parse_args(ok) == 0 && parser.parse_args(bad) == -1;
+        });
+        
+        run_test("Range on non-numeric argument throws", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--name"}, "Name", STR);
+            try {
+                parser.set_range("name", 0, 1);
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+        
+        run_test("Range on unknown key throws", [&]() {
+            ArgumentParser parser("test");
+            try {
+                parser.set_range("missing", 0, 1);
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+    }
+    
+    void test_regex_patterns() {
+        print_test_header("Regex Pattern Validation");
+        
+        run_test("Matching STR value accepted", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--version"}, "Semantic version", STR);
+            parser.set_pattern("version", "[0-9]+\\.[0-9]+\\.[0-9]+");
+            
+            std::vector<std::string> args = {"test", "--version", "1.2.3"};
+            return parser.parse_args(args) == 0 && parser.get<std::string>("version") == "1.2.3";
+        });
+        
+        run_test("Partial match rejected", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--version"}, "Semantic version", STR);
+            parser.set_pattern("version", "[0-9]+\\.[0-9]+\\.[0-9]+");
+            
+            std::vector<std::string> args = {"test", "--version", "1.2.3-beta"};
+            return parser.parse_args(args) == -1;
+        });
+        
+        run_test("Pattern checked on every nargs element", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"ids"}, "Ids", STR, "", false, "", {}, "", "*");
+            parser.add_argument({"--hosts"}, "Hosts", STR, "", false, "", {}, "", "+");
+            parser.set_pattern("hosts", "[a-z0-9-]+(\\.[a-z0-9-]+)*");
+            
+            std::vector<std::string> ok = {"test", "--hosts", "a.example.com", "db-1"};
+            std::vector<std::string> bad = {"test", "--hosts", "a.example.com", "Bad_Host"};
+            return parser.parse_args(ok) == 0 && parser.get_list<std::string>("hosts").size() == 2 &&
+                   parser.parse_args(bad) == -1;
+        });
+        
+        run_test("Invalid pattern throws at registration", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--id"}, "Id", STR);
+            try {
+                parser.set_pattern("id", "[unclosed");
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+        
+        run_test("Pattern on non-STR argument throws", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--count"}, "Count", INT);
+            try {
+                parser.set_pattern("count", "[0-9]+");
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+    }
+    
+    void test_path_arguments() {
+        print_test_header("PATH Arguments");
+        
+        char tmpl[] = "/tmp/argparse_test_XXXXXX";
+        int fd = mkstemp(tmpl);
+        if (fd >= 0) close(fd);
+        std::string tmp_file = tmpl;
+        
+        run_test("PATH without checks accepts anything", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--out"}, "Output path", PATH);
+            
+            std::vector<std::string> args = {"test", "--out", "/nonexistent/dir/file"};
+            return parser.parse_args(args) == 0 && parser.get<std::string>("out") == "/nonexistent/dir/file";
+        });
+        
+        run_test("PATH_EXISTS rejects missing path", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--in"}, "Input path", PATH);
+            parser.set_path_checks("in", PATH_EXISTS);
+            
+            std::vector<std::string> ok = {"test", "--in", tmp_file};
+            std::vector<std::string> bad = {"test", "--in", tmp_file + ".missing"};
+            return parser.parse_args(ok) == 0 && parser.parse_args(bad) == -1;
+        });
+        
+        run_test("PATH_FILE and PATH_DIR check file type", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--file"}, "File", PATH);
+            parser.add_argument({"--dir"}, "Directory", PATH);
+            parser.set_path_checks("file", PATH_FILE | PATH_READABLE);
+            parser.set_path_checks("dir", PATH_DIR);
+            
+            std::vector<std::string> ok = {"test", "--file", tmp_file, "--dir", "/tmp"};
+            std::vector<std::string> bad_file = {"test", "--file", "/tmp"};
+            std::vector<std::string> bad_dir = {"test", "--dir", tmp_file};
+            return parser.parse_args(ok) == 0 && parser.parse_args(bad_file) == -1 &&
+                   parser.parse_args(bad_dir) == -1;
+        });
+        
+        run_test("Large PATH list checked in parallel", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"inputs"}, "Input files", PATH, "", false, "", {}, "", "+");
+            parser.add_argument({"--files"}, "Input files", PATH, "", false, "", {}, "", "+");
+            parser.set_path_checks("files", PATH_FILE);
+            
+            std::vector<std::string> args = {"test", "--files"};
+            for (int i = 0; i < 5000; i++) args.push_back(tmp_file);
+            if (parser.parse_args(args) != 0 || parser.get_list<std::string>("files").size() != 5000) {
+                return false;
+            }
+            args[100] = tmp_file + ".missing1";
+            args[4000] = tmp_file + ".missing2";
+            return parser.parse_args(args) == -1;
+        });
+        
+        run_test("Path checks on non-PATH argument throw", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--name"}, "Name", STR);
+            try {
+                parser.set_path_checks("name", PATH_EXISTS);
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+        
+        unlink(tmp_file.c_str());
+    }
+    
+    void test_glob_expansion() {
+        print_test_header("Glob Expansion");
+        
+        char tmpl[] = "/tmp/argparse_glob_XXXXXX";
+        std::string root = mkdtemp(tmpl);
+        mkdir((root + "/b").c_str(), 0755);
+        mkdir((root + "/b/c").c_str(), 0755);
+        const std::vector<std::string> files = {"/x.txt", "/w.log", "/b/y.txt", "/b/c/z.txt", "/b/c/.hidden.txt"};
+        for (const auto& f : files) std::ofstream(root + f) << "data";
+        
+        run_test("Single-level wildcard is expanded and sorted", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--inputs"}, "Inputs", STR, "", false, "", {}, "", "+");
+            parser.set_glob("inputs");
+            
+            std::vector<std::string> args = {"test", "--inputs", root + "/*"};
+            if (parser.parse_args(args) != 0) return false;
+            auto inputs = parser.get_list<std::string>("inputs");
+            return inputs == std::vector<std::string>{root + "/b", root + "/w.log", root + "/x.txt"};
+        });
+        
+        run_test("Recursive ** pattern", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--inputs"}, "Inputs", PATH, "", false, "", {}, "", "+");
+            parser.set_glob("inputs");
+            
+            std::vector<std::string> args = {"test", "--inputs", root + "/**/*.txt"};
+            if (parser.parse_args(args) != 0) return false;
+            auto inputs = parser.get_list<std::string>("inputs");
+            return inputs == std::vector<std::string>{root + "/b/c/z.txt", root + "/b/y.txt", root + "/x.txt"};
+        });
+        
+        run_test("Literal values pass through unchanged", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--inputs"}, "Inputs", STR, "", false, "", {}, "", "+");
+            parser.set_glob("inputs");
+            
+            std::vector<std::string> args = {"test", "--inputs", "literal", root + "/b/*.txt"};
+            if (parser.parse_args(args) != 0) return false;
+            auto inputs = parser.get_list<std::string>("inputs");
+            return inputs == std::vector<std::string>{"literal", root + "/b/y.txt"};
+        });
+        
+        run_test("Expansion falls back when threads cannot be created", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--inputs"}, "Inputs", PATH, "", false, "", {}, "", "+");
+            parser.set_glob("inputs");
+            
+            std::vector<std::string> args = {"test", "--inputs", root + "/**/*.txt"};
+            g_thread_budget = 0;
+            bool parsed = parser.parse_args(args) == 0;
+            g_thread_budget = -1;
+            return parsed && parser.get_list<std::string>("inputs") ==
+                   std::vector<std::string>{root + "/b/c/z.txt", root + "/b/y.txt", root + "/x.txt"};
+        });
+        
+        run_test("Match cap and empty match are errors", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--inputs"}, "Inputs", STR, "", false, "", {}, "", "+");
+            parser.set_glob("inputs", 2);
+            
+            std::vector<std::string> too_many = {"test", "--inputs", root + "/**/*.txt"};
+            std::vector<std::string> none = {"test", "--inputs", root + "/*.csv"};
+            return parser.parse_args(too_many) == -1 && parser.parse_args(none) == -1;
+        });
+        
+        run_test("Glob on single-value argument throws", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--input"}, "Input", STR);
+            try {
+                parser.set_glob("input");
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+        
+        for (const auto& f : files) unlink((root + f).c_str());
+        rmdir((root + "/b/c").c_str());
+        rmdir((root + "/b").c_str());
+        rmdir(root.c_str());
+    }
+    
+    void test_file_and_blob_arguments() {
+        print_test_header("File Views and BLOB Arguments");
+        
+        char tmpl[] = "/tmp/argparse_file_XXXXXX";
+        int fd = mkstemp(tmpl);
+        if (fd >= 0) close(fd);
+        std::string tmp_file = tmpl;
+        std::ofstream(tmp_file) << "secret key material";
+        
+        run_test("@path value is viewed through the file", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--key"}, "Key", STR);
+            
+            std::vector<std::string> args = {"test", "--key", "@" + tmp_file};
+            if (parser.parse_args(args) != 0) return false;
+            FileView view = parser.get_file("key");
+            return view.is_file() && view.path() == tmp_file && view.view() == "secret key material";
+        });
+        
+        run_test("file: prefix and inline values", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--a"}, "A", STR);
+            parser.add_argument({"--b"}, "B", STR);
+            
+            std::vector<std::string> args = {"test", "--a", "file:" + tmp_file, "--b", "inline text"};
+            if (parser.parse_args(args) != 0) return false;
+            return parser.get_file("a").size() == 19 && !parser.get_file("b").is_file() &&
+                   parser.get_file("b").view() == "inline text";
+        });
+        
+        run_test("Missing file only fails on access", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--key"}, "Key", STR);
+            
+            std::vector<std::string> args = {"test", "--key", "@" + tmp_file + ".missing"};
+            if (parser.parse_args(args) != 0) return false;
+            FileView view = parser.get_file("key");
+            try {
+                view.data();
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+        
+        run_test("BLOB hex and base64 decoding", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--hex"}, "Hex blob", BLOB);
+            parser.add_argument({"--b64"}, "Base64 blob", BLOB);
+            
+            std::vector<std::string> args = {"test", "--hex", "hex:DEADbeef00", "--b64", "base64:aGVsbG8="};
+            if (parser.parse_args(args) != 0) return false;
+            auto hex = parser.get_blob("hex");
+            auto b64 = parser.get_blob("b64");
+            return hex == std::vector<unsigned char>{0xde, 0xad, 0xbe, 0xef, 0x00} &&
+                   std::string(b64.begin(), b64.end()) == "hello";
+        });
+        
+        run_test("BLOB from file reference", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--weights"}, "Weights", BLOB);
+            
+            std::vector<std::string> args = {"test", "--weights", "@" + tmp_file};
+            if (parser.parse_args(args) != 0) return false;
+            auto bytes = parser.get_blob("weights");
+            return std::string(bytes.begin(), bytes.end()) == "secret key material";
+        });
+        
+        run_test("Malformed BLOB values rejected", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--data"}, "Data", BLOB);
+            
+            std::vector<std::string> odd = {"test", "--data", "hex:abc"};
+            std::vector<std::string> bad_char = {"test", "--data", "base64:ab$d"};
+            std::vector<std::string> no_prefix = {"test", "--data", "deadbeef"};
+            return parser.parse_args(odd) == -1 && parser.parse_args(bad_char) == -1 &&
+                   parser.parse_args(no_prefix) == -1;
+        });
+        
+        unlink(tmp_file.c_str());
+    }
+    
+    // Write a version 1.0 .npy file holding the given little-endian data
+    static void write_npy(const std::string& path, const std::string& descr, const std::string& shape,
+                          const void* data, size_t bytes) {
+        std::string header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+        while ((10 + header.size() + 1) % 64 != 0) header += ' ';
+        header += '\n';
+        std::ofstream out(path, std::ios::binary);
+        out.write("\x93NUMPY\x01\x00", 8);
+        unsigned char len[2] = {(unsigned char)(header.size() & 0xff), (unsigned char)(header.size() >> 8)};
+        out.write((const char*)len, 2);
+        out << header;
+        out.write((const char*)data, bytes);
+    }
+    
+    void test_binary_arrays() {
+        print_test_header("Binary Array Arguments");
+        
+        std::string npy_file = "/tmp/argparse_array_" + std::to_string(getpid()) + ".npy";
+        std::string raw_file = "/tmp/argparse_array_" + std::to_string(getpid()) + ".bin";
+        std::vector<float> weights = {0.5f, -1.25f, 2.0f, 3.5f, 0.0f, 1.0f};
+        std::vector<int> ids = {7, 8, 9, 10};
+        
+        run_test(".npy float array exposed as a view", [&]() {
+            write_npy(npy_file, "<f4", "(2, 3)", weights.data(), weights.size() * sizeof(float));
+            ArgumentParser parser("test");
+            parser.add_argument({"--weights"}, "Weights file", PATH);
+            parser.set_array("weights", FLOAT);
+            
+            std::vector<std::string> args = {"test", "--weights", npy_file};
+            if (parser.parse_args(args) != 0) return false;
+            ArrayView<float> w = parser.get_array<float>("weights");
+            return w.size() == 6 && w[1] == -1.25f && std::vector<float>(w.begin(), w.end()) == weights;
+        });
+        
+        run_test("Raw int32 array", [&]() {
+            std::ofstream(raw_file, std::ios::binary).write((const char*)ids.data(), ids.size() * sizeof(int));
+            ArgumentParser parser("test");
+            parser.add_argument({"--ids"}, "Ids file", STR);
+            parser.set_array("ids", INT);
+            
+            std::vector<std::string> args = {"test", "--ids", raw_file};
+            if (parser.parse_args(args) != 0) return false;
+            ArrayView<int> v = parser.get_array<int>("ids");
+            return v.size() == 4 && v[3] == 10;
+        });
+        
+        run_test("dtype and length mismatches rejected", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--ids"}, "Ids file", STR);
+            parser.set_array("ids", INT);
+            
+            write_npy(npy_file, "<f4", "(6,)", weights.data(), weights.size() * sizeof(float));
+            std::vector<std::string> args = {"test", "--ids", npy_file};
+            bool dtype_rejected = parser.parse_args(args) == -1;
+            write_npy(npy_file, "<i4", "(5,)", ids.data(), ids.size() * sizeof(int));
+            bool length_rejected = parser.parse_args(args) == -1;
+            return dtype_rejected && length_rejected;
+        });
+        
+        run_test("Oversized .npy shapes rejected", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--ids"}, "Ids file", STR);
+            parser.set_array("ids", INT);
+            std::vector<std::string> args = {"test", "--ids", npy_file};
+            
+            write_npy(npy_file, "<i4", "(4611686018427387905,)", ids.data(), sizeof(int));
+            bool count_rejected = parser.parse_args(args) == -1;
+            write_npy(npy_file, "<i4", "(4294967296, 4294967296)", ids.data(), sizeof(int));
+            bool product_rejected = parser.parse_args(args) == -1;
+            write_npy(npy_file, "<i4", "(99999999999999999999999,)", ids.data(), sizeof(int));
+            bool digits_rejected = parser.parse_args(args) == -1;
+            return count_rejected && product_rejected && digits_rejected;
+        });
+        
+        run_test("NaN and range scan", [&]() {
+            std::vector<float> bad = {0.1f, std::nanf(""), 0.3f};
+            write_npy(npy_file, "<f4", "(3,)", bad.data(), bad.size() * sizeof(float));
+            ArgumentParser parser("test");
+            parser.add_argument({"--w"}, "Weights", PATH);
+            parser.set_array("w", FLOAT, true);
+            std::vector<std::string> args = {"test", "--w", npy_file};
+            bool nan_rejected = parser.parse_args(args) == -1;
+            
+            write_npy(npy_file, "<f4", "(2, 3)", weights.data(), weights.size() * sizeof(float));
+            parser.set_range("w", -2.0, 3.0);
+            bool range_rejected = parser.parse_args(args) == -1;
+            parser.set_range("w", -2.0, 4.0);
+            return nan_rejected && range_rejected && parser.parse_args(args) == 0;
+        });
+        
+        run_test("get_array type mismatch throws", [&]() {
+            std::ofstream(raw_file, std::ios::binary).write((const char*)ids.data(), ids.size() * sizeof(int));
+            ArgumentParser parser("test");
+            parser.add_argument({"--ids"}, "Ids file", STR);
+            parser.set_array("ids", INT);
+            
+            std::vector<std::string> args = {"test", "--ids", raw_file};
+            parser.parse_args(args);
+            try {
+                parser.get_array<float>("ids");
+                return false;
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+        });
+        
+        unlink(npy_file.c_str());
+        unlink(raw_file.c_str());
+    }
+    
+    void test_command_line_tokenizer() {
+        print_test_header("Command String Tokenizer");
+        
+        run_test("Whitespace splitting and quoting", [&]() {
+            auto tokens = split_command_line("  a  'b c'\t\"d e\" f'g'\"h\"  ");
+            return tokens == std::vector<std::string>{"a", "b c", "d e", "fgh"};
+        });
+        
+        run_test("Backslash escapes", [&]() {
+            auto tokens = split_command_line("a\\ b \\\\ \"x\\\"y\\n\" 'lit\\eral'");
+            return tokens == std::vector<std::string>{"a b", "\\", "x\"y\\n", "lit\\eral"};
+        });
+        
+        run_test("Empty quoted tokens and line continuation", [&]() {
+            auto tokens = split_command_line("'' \"\" a\\\nb \\\n c");
+            return tokens == std::vector<std::string>{"", "", "ab", "c"};
+        });
+        
+        run_test("Unterminated quote and trailing backslash throw", [&]() {
+            int errors = 0;
+            for (const char* line : {"a 'b", "a \"b", "a \\"}) {
+                try {
+                    split_command_line(line);
+                } catch (const ArgParseException&) {
+                    errors++;
+                }
+            }
+            return errors == 3;
+        });
+        
+        run_test("Incremental feeding across chunk boundaries", [&]() {
+            CommandTokenizer tok;
+            std::vector<std::string> tokens;
+            tok.feed("--name 'hello wo", tokens);
+            tok.feed("rld' -v \"x\\", tokens);
+            tok.feed("\"y\"", tokens);
+            tok.finish(tokens);
+            return tokens == std::vector<std::string>{"--name", "hello world", "-v", "x\"y"};
+        });
+        
+        run_test("parse_command_line parses a whole string", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"input"}, "Input", STR, "", true);
+            parser.add_argument({"--count"}, "Count", INT, "1");
+            parser.add_argument({"--tags"}, "Tags", STR, "", false, "", {}, "", "+");
+            
+            int result = parser.parse_command_line("'my file.txt' --count 3 --tags \"a b\" c");
+            return result == 0 && parser.get<std::string>("input") == "my file.txt" &&
+                   parser.get<int>("count") == 3 &&
+                   parser.get_list<std::string>("tags") == std::vector<std::string>{"a b", "c"};
+        });
+        
+        run_test("parse_command_line reports quoting errors", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--name"}, "Name", STR);
+            return parser.parse_command_line("--name 'oops") == -1;
+        });
+    }
+    
+    void test_repl_and_completion() {
+        print_test_header("REPL and Completion");
+        
+        run_test("Alias completion from prefix", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"-f", "--force"}, "Force", BOOL);
+            parser.add_argument({"--format"}, "Format", STR, "", false, "", {"json", "xml", "jsonl"});
+            parser.add_argument({"--count"}, "Count", INT);
+            
+            return parser.complete("--fo") == std::vector<std::string>{"--force", "--format"} &&
+                   parser.complete("-v --c") == std::vector<std::string>{"--count"} &&
+                   parser.complete("--x").empty();
+        });
+        
+        run_test("Choice completion after an option", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--format"}, "Format", STR, "", false, "", {"json", "xml", "jsonl"});
+            
+            return parser.complete("--format j") == std::vector<std::string>{"json", "jsonl"} &&
+                   parser.complete("--format ").size() == 3;
+        });
+        
+        run_test("execute() parses and dispatches each line", [&]() {
+            ArgumentParser parser("console");
+            parser.add_argument({"cmd"}, "Command", STR, "", true, "", {"get", "set"});
+            parser.add_argument({"--key"}, "Key", STR);
+            
+            std::vector<std::string> seen;
+            ArgumentRepl repl(parser, [&](const ArgumentParser& p) {
+                seen.push_back(p.get<std::string>("cmd") + ":" + p.get<std::string>("key"));
+                return 0;
+            });
+            bool ok = repl.execute("get --key 'a b'") == 0 && repl.execute("   ") == 0 &&
+                      repl.execute("bogus") == -1 && repl.execute("set --key c") == 0;
+            return ok && seen == std::vector<std::string>{"get:a b", "set:c"};
+        });
+        
+        run_test("run() stops on non-zero handler result", [&]() {
+            ArgumentParser parser("console");
+            parser.add_argument({"cmd"}, "Command", STR, "", true);
+            
+            int calls = 0;
+            ArgumentRepl repl(parser, [&](const ArgumentParser& p) {
+                calls++;
+                return p.get<std::string>("cmd") == "quit" ? 42 : 0;
+            });
+            FILE* in = tmpfile();
+            fputs("one\n--bad\ntwo\nquit\nnever\n", in);
+            rewind(in);
+            int result = repl.run(in);
+            fclose(in);
+            return result == 42 && calls == 3;
+        });
+    }
+    
+    void test_command_chains() {
+        print_test_header("Chained Commands");
+        
+        ArgumentParser load("load", "Load a table");
+        load.add_argument({"--src"}, "Source", STR, "", true);
+        ArgumentParser filter("filter", "Filter rows");
+        filter.add_argument({"--expr"}, "Expression", STR, "", true);
+        filter.add_argument({"--limit"}, "Row limit", INT, "0");
+        ArgumentParser write("write", "Write a table");
+        write.add_argument({"--dst"}, "Destination", STR, "", true);
+        
+        run_test("Stages parsed in order with their own specs", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_argument({"-v", "--verbose"}, "Verbose", BOOL);
+            parser.add_command("load", load);
+            parser.add_command("filter", filter);
+            parser.add_command("write", write);
+            
+            std::vector<std::string> args = {"tool", "-v", "load", "--src", "a", "+", "filter", "--expr", "x > 1",
+                                             "+", "filter", "--expr", "y", "--limit", "5", "+", "write", "--dst", "b"};
+            std::vector<CommandResult_t> stages;
+            if (parser.parse_chain(args, stages) != 0 || stages.size() != 5) return false;
+            return stages[0].command == "" && stages[0].get<bool>("verbose") &&
+                   parser.get_opt_args().empty() &&
+                   stages[1].command == "load" && stages[1].get<std::string>("src") == "a" &&
+                   stages[2].command == "filter" && stages[2].get<std::string>("expr") == "x > 1" &&
+                   stages[2].get<int>("limit") == 0 &&
+                   stages[3].command == "filter" && stages[3].get<int>("limit") == 5 &&
+                   stages[4].command == "write" && stages[4].get<std::string>("dst") == "b";
+        });
+        
+        run_test("Option values may be a command name or the delimiter", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_argument({"--name"}, "Name", STR);
+            parser.add_argument({"--pair"}, "Pair", STR, "", false, "", {}, "", "2");
+            parser.add_command("load", load);
+            parser.add_command("filter", filter);
+            parser.add_command("write", write);
+            
+            std::vector<std::string> args = {"tool", "--name", "load", "--pair", "+", "write", "load", "--src", "a",
+                                             "+", "filter", "--expr", "+", "--limit", "2", "+", "write", "--dst", "load"};
+            std::vector<CommandResult_t> stages;
+            if (parser.parse_chain(args, stages) != 0 || stages.size() != 4) return false;
+            return stages[0].get<std::string>("name") == "load" &&
+                   stages[0].get<std::vector<std::string>>("pair") == std::vector<std::string>{"+", "write"} &&
+                   stages[1].get<std::string>("src") == "a" &&
+                   stages[2].get<std::string>("expr") == "+" && stages[2].get<int>("limit") == 2 &&
+                   stages[3].get<std::string>("dst") == "load";
+        });
+        
+        run_test("Custom delimiter and long pipelines", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_command("filter", filter);
+            
+            std::vector<std::string> args = {"tool"};
+            for (int i = 0; i < 300; i++) {
+                if (i > 0) args.push_back("::");
+                args.push_back("filter");
+                args.push_back("--expr");
+                args.push_back("e" + std::to_string(i));
+            }
+            std::vector<CommandResult_t> stages;
+            return parser.parse_chain(args, stages, "::") == 0 && stages.size() == 301 &&
+                   stages[300].get<std::string>("expr") == "e299";
+        });
+        
+        run_test("Stage errors fail the whole chain", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_command("load", load);
+            parser.add_command("write", write);
+            
+            std::vector<CommandResult_t> stages;
+            std::vector<std::string> unknown = {"tool", "load", "--src", "a", "+", "bogus"};
+            std::vector<std::string> missing = {"tool", "load", "--src", "a", "+", "write"};
+            std::vector<std::string> trailing = {"tool", "load", "--src", "a", "+"};
+            return parser.parse_chain(unknown, stages) == -1 && stages.empty() &&
+                   parser.parse_chain(missing, stages) == -1 &&
+                   parser.parse_chain(trailing, stages) == -1;
+        });
+        
+        run_test("Duplicate command registration throws", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_command("load", load);
+            try {
+                parser.add_command("load", load);
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+    }
+    
+    void test_action_callbacks() {
+        print_test_header("Action Callbacks");
+        
+        run_test("Stop action short-circuits parsing", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"input"}, "Input", STR, "", true);
+            parser.add_argument({"--version"}, "Show version", BOOL);
+            parser.add_argument({"--count"}, "Count", INT);
+            int calls = 0;
+            parser.set_action("version", [&](const ArgVal_t&) { calls++; return ACTION_STOP; });
+            
+            // Required input missing and a bad value after --version: neither is looked at
+            std::vector<std::string> args = {"test", "--version", "--count", "not_a_number"};
+            return parser.parse_args(args) == 1 && calls == 1;
+        });
+        
+        run_test("Continue action sees converted value in order", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--db"}, "Database", STR);
+            parser.add_argument({"--ids"}, "Ids", INT, "", false, "", {}, "", "+");
+            std::vector<std::string> order;
+            parser.set_action("db", [&](const ArgVal_t& v) {
+                order.push_back("db=" + std::get<std::string>(v.value));
+                return ACTION_CONTINUE;
+            });
+            parser.set_action("ids", [&](const ArgVal_t& v) {
+                order.push_back("ids=" + std::to_string(std::get<std::vector<int>>(v.value).size()));
+                return ACTION_CONTINUE;
+            });
+            
+            std::vector<std::string> args = {"test", "--ids", "1", "2", "3", "--db", "main.sqlite"};
+            return parser.parse_args(args) == 0 &&
+                   order == std::vector<std::string>{"ids=3", "db=main.sqlite"} &&
+                   parser.get<std::string>("db") == "main.sqlite";
+        });
+        
+        run_test("Action exceptions become parse errors", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--plugin"}, "Plugin", STR);
+            parser.set_action("plugin", [](const ArgVal_t&) -> ActionResult_t {
+                throw ArgParseException("plugin not found");
+            });
+            
+            std::vector<std::string> args = {"test", "--plugin", "x"};
+            return parser.parse_args(args) == -1;
+        });
+        
+        run_test("Action on positional argument throws", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"input"}, "Input", STR);
+            try {
+                parser.set_action("input", [](const ArgVal_t&) { return ACTION_CONTINUE; });
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+    }
+    
+    void test_help_fast_path() {
+        print_test_header("Help Fast Path");
+        
+        run_test("Help skips default materialization", [&]() {
+            ArgumentParser parser("test");
+            for (int i = 0; i < 3000; i++) {
+                parser.add_argument({"--opt" + std::to_string(i)}, "Option", INT, std::to_string(i));
+            }
+            std::vector<std::string> args = {"test", "--opt1", "bad", "--help"};
+            int result = 0;
+            capture_stdout([&]() { result = parser.parse_args(args); });
+            return result == 1 && parser.get_all_keys() == std::vector<std::string>{"help"};
+        });
+        
+        run_test("Early-exit flag found before other tokens are parsed", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"input"}, "Input", STR, "", true);
+            parser.add_argument({"--version"}, "Version", BOOL);
+            int calls = 0;
+            parser.set_action("version", [&](const ArgVal_t&) { calls++; return ACTION_STOP; }, true);
+            
+            std::vector<std::string> args = {"test", "--unknown", "--version"};
+            return parser.parse_args(args) == 1 && calls == 1;
+        });
+        
+        run_test("Early-exit action that continues runs once", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--trace"}, "Trace", BOOL);
+            int calls = 0;
+            parser.set_action("trace", [&](const ArgVal_t&) { calls++; return ACTION_CONTINUE; }, true);
+            
+            std::vector<std::string> args = {"test", "--trace"};
+            return parser.parse_args(args) == 0 && calls == 1 && parser.get<bool>("trace");
+        });
+        
+        run_test("Double dash ends options", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"first"}, "First", STR);
+            parser.add_argument({"second"}, "Second", STR);
+            parser.add_argument({"-v"}, "Verbose", BOOL);
+            
+            std::vector<std::string> args = {"test", "-v", "--", "--help", "-v"};
+            return parser.parse_args(args) == 0 && parser.get<bool>("v") &&
+                   parser.get<std::string>("first") == "--help" && parser.get<std::string>("second") == "-v";
+        });
+        
+        run_test("Early exit requires BOOL flag", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--level"}, "Level", INT);
+            try {
+                parser.set_action("level", [](const ArgVal_t&) { return ACTION_STOP; }, true);
+                return false;
+            } catch (const ArgParseException&) {
+                return true;
+            }
+        });
+    }
+    
+    void test_help_search() {
+        print_test_header("Help Search");
+        
+        auto make_parser = []() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--listen-port"}, "TCP port to listen on", INT);
+            parser.add_argument({"--cache-dir"}, "Directory for cached blobs", PATH);
+            parser.add_argument({"--dry-run"}, "Print actions without running them", BOOL);
+            parser.add_argument({"target"}, "Deployment target host", STR);
+            return parser;
+        };
+        
+        run_test("Pattern matches alias words", [&]() {
+            ArgumentParser parser = make_parser();
+            std::vector<std::string> args = {"test", "--help=port"};
+            int result = 0;
+            std::string out = capture_stdout([&]() { result = parser.parse_args(args); });
+            return result == 1 && out.find("--listen-port") != std::string::npos &&
+                   out.find("--cache-dir") == std::string::npos && out.find("--dry-run") == std::string::npos;
+        });
+        
+        run_test("Pattern matches help-text prefixes, all words required", [&]() {
+            ArgumentParser parser = make_parser();
+            std::string one = capture_stdout([&]() { parser.print_help("direct"); });
+            std::string both = capture_stdout([&]() { parser.print_help("deploy host"); });
+            std::string none = capture_stdout([&]() { parser.print_help("deploy port"); });
+            return one.find("--cache-dir") != std::string::npos && one.find("--listen-port") == std::string::npos &&
+                   both.find("target") != std::string::npos &&
+                   none.find("No options match") != std::string::npos;
+        });
+        
+        run_test("Index follows spec changes", [&]() {
+            ArgumentParser parser = make_parser();
+            capture_stdout([&]() { parser.print_help("port"); });
+            parser.add_argument({"--admin-port"}, "Admin port", INT);
+            parser.set_range("admin_port", 1, 1024);
+            std::string out = capture_stdout([&]() { parser.print_help("port"); });
+            return out.find("--admin-port") != std::string::npos && out.find("range: [1, 1024]") != std::string::npos &&
+                   out.find("--listen-port") != std::string::npos;
+        });
+    }
+    
+    void test_argument_groups() {
+        print_test_header("Argument Groups");
+        
+        run_test("Grouped arguments get their own help section", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--verbose"}, "Verbose output", BOOL);
+            parser.begin_group("Networking", "Connection settings");
+            parser.add_argument({"--host"}, "Server host", STR, "localhost");
+            parser.add_argument({"--port"}, "Server port", INT, "80");
+            parser.end_group();
+            parser.add_argument({"--quiet"}, "Quiet output", BOOL);
+            std::string out = capture_stdout([&]() { parser.print_help(); });
+            size_t net = out.find("Networking:");
+            return net != std::string::npos && out.find("Connection settings") > net &&
+                   out.find("--host") > net && out.find("--port") > net &&
+                   out.find("--verbose") < net && out.find("--quiet") < net &&
+                   parser.parse_args({"test", "--port", "8080"}) == 0 && parser.get<int>("port") == 8080;
+        });
+        
+        run_test("Lazy group loads when one of its options is parsed", [&]() {
+            ArgumentParser parser("test");
+            int loads = 0;
+            parser.add_argument({"--verbose"}, "Verbose output", BOOL);
+            parser.add_lazy_group("Storage", "Object store access", {"--bucket", "--region"},
+                [&](ArgumentParser& p) {
+                    loads++;
+                    p.add_argument({"--bucket"}, "Bucket name", STR);
+                    p.add_argument({"--region"}, "Region", STR, "us-east-1");
+                });
+            bool untouched = parser.parse_args({"test", "--verbose"}) == 0 && loads == 0 &&
+                             !parser.has_argument("bucket");
+            bool loaded = parser.parse_args({"test", "--bucket", "logs"}) == 0 && loads == 1 &&
+                          parser.get<std::string>("bucket") == "logs" &&
+                          parser.get<std::string>("region") == "us-east-1";
+            bool again = parser.parse_args({"test", "--region", "eu-west-1"}) == 0 && loads == 1 &&
+                         parser.get<std::string>("region") == "eu-west-1";
+            return untouched && loaded && again;
+        });
+        
+        run_test("Help lists lazy aliases; --help-section loads the group", [&]() {
+            ArgumentParser parser("test");
+            int loads = 0;
+            parser.add_lazy_group("Storage", "Object store access", {"--bucket"},
+                [&](ArgumentParser& p) {
+                    loads++;
+                    p.add_argument({"--bucket"}, "Bucket name", STR);
+                });
+            std::string full = capture_stdout([&]() { parser.print_help(); });
+            int result = 0;
+            std::string section = capture_stdout([&]() { result = parser.parse_args({"test", "--help-section=Storage"}); });
+            return full.find("--bucket") != std::string::npos && full.find("Bucket name") == std::string::npos &&
+                   result == 1 && loads == 1 && section.find("Bucket name") != std::string::npos &&
+                   parser.parse_args({"test", "--help-section=Nope"}) == -1;
+        });
+        
+        run_test("Lazy group registration errors", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--host"}, "Host", STR);
+            bool taken = false, positional = false;
+            try {
+                parser.add_lazy_group("Net", "", {"--host"}, [](ArgumentParser&) {});
+            } catch (const ArgParseException&) { taken = true; }
+            parser.add_lazy_group("Files", "", {"--input"}, [](ArgumentParser& p) {
+                p.add_argument({"--input"}, "Input", STR);
+                p.add_argument({"source"}, "Source", STR);
+            });
+            positional = parser.parse_args({"test", "--input", "a"}) == -1;
+            return taken && positional;
+        });
+        
+        run_test("Parser is unchanged after a failed lazy group", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--host"}, "Host", STR, "localhost");
+            int loads = 0;
+            parser.add_lazy_group("Files", "", {"--input"}, [&](ArgumentParser& p) {
+                loads++;
+                p.add_argument({"--input"}, "Input", STR);
+                p.add_argument({"source"}, "Source", STR);
+            });
+            parser.add_lazy_group("Net", "", {"--port"}, [](ArgumentParser& p) {
+                p.add_argument({"--port"}, "Port", INT);
+                throw std::runtime_error("registrar failed");
+            });
+            bool positional = parser.parse_args({"test", "--input", "a"}) == -1;
+            bool thrown = false;
+            try {
+                parser.parse_args({"test", "--port", "80"});
+            } catch (const std::runtime_error&) { thrown = true; }
+            parser.add_argument({"--later"}, "Added after the failures", STR);
+            std::string help = capture_stdout([&]() { parser.print_help(); });
+            bool usable = parser.parse_args({"test", "--host", "example.org"}) == 0 &&
+                          parser.get<std::string>("host") == "example.org" &&
+                          !parser.has_argument("input") && !parser.has_argument("source") &&
+                          !parser.has_argument("port") && parser.get_pos_args().empty();
+            bool retried = parser.parse_args({"test", "--input", "a"}) == -1 && loads == 2;
+            return positional && thrown && usable && retried &&
+                   help.find("Added after the failures") < help.find("Net");
+        });
+        
+        run_test("Completion offers options of unloaded groups", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--base"}, "Base", STR);
+            parser.add_lazy_group("Storage", "", {"--bucket"}, [](ArgumentParser& p) {
+                p.add_argument({"--bucket"}, "Bucket", STR);
+            });
+            auto c = parser.complete("--b");
+            return c == std::vector<std::string>{"--base", "--bucket"};
+        });
+    }
+    
+    void test_help_resource() {
+        print_test_header("Help Resource");
+        
+        run_test("Help text is read from a resource file", [&]() {
+            std::string path = "/tmp/argparse_help_resource.tsv";
+            {
+                std::ofstream f(path);
+                f << "# tool help\n:description\tResource description\nport\tServer port from resource\n"
+                  << "host\tIgnored: inline help wins\n:epilog\tSee the manual\n";
+            }
+            ArgumentParser parser("test");
+            parser.add_argument({"--port"}, "", INT, "80");
+            parser.add_argument({"--host"}, "Inline host help", STR);
+            parser.set_help_resource(path);
+            std::string out = capture_stdout([&]() { parser.print_help(); });
+            std::string found = capture_stdout([&]() { parser.print_help("resource"); });
+            std::remove(path.c_str());
+            return out.find("Description: Resource description") != std::string::npos &&
+                   out.find("Server port from resource") != std::string::npos &&
+                   out.find("Inline host help") != std::string::npos &&
+                   out.find("Ignored") == std::string::npos &&
+                   out.find("See the manual") != std::string::npos &&
+                   found.find("--port") != std::string::npos;
+        });
+        
+        run_test("Resource is not needed for parsing", [&]() {
+            ArgumentParser parser("test");
+            parser.add_argument({"--port"}, "", INT, "80");
+            parser.set_help_resource("/nonexistent/help.tsv");
+            bool parsed = parser.parse_args({"test", "--port", "8080"}) == 0 && parser.get<int>("port") == 8080;
+            std::string out = capture_stdout([&]() { parser.print_help(); });
+            return parsed && out.find("--port N") != std::string::npos;
+        });
+        
+        run_test("In-memory resource", [&]() {
+            static const char text[] = "verbose\tChatty output\r\nbroken line without tab\n";
+            ArgumentParser parser("test");
+            parser.add_argument({"-v", "--verbose"}, "", BOOL);
+            parser.set_help_resource(text, sizeof(text) - 1);
+            std::string out = capture_stdout([&]() { parser.print_help(); });
+            return out.find("    Chatty output\n") != std::string::npos && out.find("broken") == std::string::npos;
+        });
+    }
+    
+    void test_c_api() {
+        print_test_header("C Interface");
+        
+        run_test("Slots read values and views from the result", [&]() {
+            argparse_spec* spec = argparse_spec_new("tool", "C tool");
+            const char* count_aliases[] = {"-n", "--count"};
+            const char* name_aliases[] = {"--name"};
+            const char* sizes_aliases[] = {"--sizes"};
+            const char* verbose_aliases[] = {"-v", "--verbose"};
+            const char* file_aliases[] = {"file"};
+            int count = argparse_spec_add(spec, count_aliases, 2, "Count", ARGPARSE_INT, "1", 0, NULL, 0, NULL);
+            int name = argparse_spec_add(spec, name_aliases, 1, "Name", ARGPARSE_STR, NULL, 0, NULL, 0, NULL);
+            int sizes = argparse_spec_add(spec, sizes_aliases, 1, "Sizes", ARGPARSE_INT, NULL, 0, NULL, 0, "+");
+            int verbose = argparse_spec_add(spec, verbose_aliases, 2, NULL, ARGPARSE_BOOL, NULL, 0, NULL, 0, NULL);
+            int file = argparse_spec_add(spec, file_aliases, 1, "File", ARGPARSE_STR, NULL, 1, NULL, 0, NULL);
+            
+            const char* argv[] = {"tool", "--name", "abc", "--sizes", "1", "2", "3", "-v", "in.txt"};
+            argparse_result* res = NULL;
+            bool ok = argparse_parse(spec, 9, argv, &res) == 0 && res != NULL;
+            argparse_spec_free(spec);       // results outlive their spec
+            
+            int n = 0, v = 0;
+            const char* s = NULL;
+            size_t len = 0, cnt = 0;
+            const int* list = NULL;
+            ok = ok && count == 0 && file == 4 && argparse_spec_slot(NULL, "count") == -1;
+            ok = ok && argparse_get_int(res, count, &n) == ARGPARSE_OK && n == 1;
+            ok = ok && argparse_get_bool(res, verbose, &v) == ARGPARSE_OK && v == 1;
+            ok = ok && argparse_get_str(res, name, &s, &len) == ARGPARSE_OK && std::string(s, len) == "abc";
+            ok = ok && argparse_get_int_list(res, sizes, &list, &cnt) == ARGPARSE_OK && cnt == 3 && list[2] == 3;
+            ok = ok && argparse_get_count(res, sizes) == 3;
+            ok = ok && argparse_get_str(res, file, &s, &len) == ARGPARSE_OK && std::string(s, len) == "in.txt";
+            ok = ok && argparse_get_pos_count(res) == 1;
+            
+            // Views point into the result: no copy per call
+            const char* first = NULL;
+            const char* second = NULL;
+            argparse_get_str(res, name, &first, &len);
+            argparse_get_str(res, name, &second, &len);
+            ok = ok && first != NULL && first == second;
+            argparse_result_free(res);
+            return ok;
+        });
+        
+        run_test("Status codes and errors", [&]() {
+            argparse_spec* spec = argparse_spec_new(NULL, NULL);
+            const char* count_aliases[] = {"--count"};
+            const char* mode_aliases[] = {"--mode"};
+            const char* modes[] = {"fast", "slow"};
+            int count = argparse_spec_add(spec, count_aliases, 1, "Count", ARGPARSE_INT, "5", 0, NULL, 0, NULL);
+            int mode = argparse_spec_add(spec, mode_aliases, 1, "Mode", ARGPARSE_STR, "fast", 0, modes, 2, NULL);
+            int bad = argparse_spec_add(spec, count_aliases, 1, "Dup", ARGPARSE_INT, "1", 1, NULL, 0, NULL);
+            bool add_error = bad == -1 && std::string(argparse_spec_error(spec)).find("required") != std::string::npos;
+            const char* level_aliases[] = {"--level"};
+            bool type_error = argparse_spec_add(spec, level_aliases, 1, "Level", (argparse_type)7, NULL, 0, NULL, 0, NULL) == -1 &&
+                              argparse_spec_add(spec, level_aliases, 1, "Level", (argparse_type)0, NULL, 0, NULL, 0, NULL) == -1 &&
+                              std::string(argparse_spec_error(spec)).find("Unknown argument type") != std::string::npos;
+            
+            const char* bad_argv[] = {"tool", "--mode", "medium"};
+            argparse_result* res = NULL;
+            bool parse_error = argparse_parse(spec, 3, bad_argv, &res) == -1 && res == NULL;
+            
+            const char* argv[] = {"tool"};
+            bool ok = argparse_parse(spec, 1, argv, &res) == 0;
+            float f = 0;
+            const char* s = NULL;
+            ok = ok && argparse_get_float(res, count, &f) == ARGPARSE_ERR_TYPE &&
+                 argparse_get_int(res, 99, NULL) == ARGPARSE_ERR_SLOT &&
+                 argparse_get_str_at(res, mode, 0, &s, NULL) == ARGPARSE_ERR_TYPE &&
+                 argparse_spec_slot(spec, "mode") == mode &&
+                 argparse_get_pos_at(res, 0, &s, NULL) == ARGPARSE_ERR_RANGE &&
+                 argparse_api_version() == ARGPARSE_C_API_VERSION;
+            argparse_result_free(res);
+            argparse_spec_free(spec);
+            return add_error && type_error && parse_error && ok;
+        });
+    }
+    
+    void test_static_parser() {
+        print_test_header("Heap-free Static Parser");
+        
+        static const char* const modes[] = {"fast", "safe"};
+        auto setup = [](StaticParser<6>& parser) {
+            parser.add_argument("--rate", "-r", "Sample rate", INT, "100");
+            parser.add_argument("--gain", nullptr, "Gain", FLOAT, "1.5");
+            parser.add_argument("--mode", nullptr, "Run mode", STR, "fast");
+            parser.add_argument("--dry-run", nullptr, "Do nothing", BOOL);
+            parser.add_argument("device", nullptr, "Device path", PATH, nullptr, true);
+            parser.set_choices("mode", modes, 2);
+            parser.set_range("rate", 1, 1000);
+        };
+        
+        run_test("Parses without touching the heap", [&]() {
+            const char* argv[] = {"agent", "-r", "250", "--dry-run", "--mode", "safe", "/dev/ttyS0"};
+            size_t before = g_allocations.load();
+            StaticParser<6> parser("agent");
+            setup(parser);
+            int result = parser.parse_args(7, argv);
+            bool ok = result == 0 && parser.get<int>("rate") == 250 && parser.get<float>("gain") == 1.5f &&
+                      parser.get<bool>("dry_run") && std::strcmp(parser.get<const char*>("mode"), "safe") == 0 &&
+                      parser.get<const char*>("device") == argv[6] &&
+                      parser.has_argument("rate") && !parser.has_argument("gain");
+            return ok && g_allocations.load() == before;
+        });
+        
+        run_test("Errors are reported without allocating", [&]() {
+            const char* bad_choice[] = {"agent", "--mode", "turbo", "dev"};
+            const char* bad_range[] = {"agent", "--rate", "5000", "dev"};
+            const char* missing[] = {"agent", "--rate", "10"};
+            const char* unknown[] = {"agent", "--nope", "dev"};
+            const char* bad_int[] = {"agent", "--rate", "12x", "dev"};
+            StaticParser<6> parser("agent");
+            setup(parser);
+            size_t before = g_allocations.load();
+            bool ok = parser.parse_args(4, bad_choice) == -1 && std::strstr(parser.error(), "turbo") &&
+                      parser.parse_args(4, bad_range) == -1 && std::strstr(parser.error(), "out of range") &&
+                      parser.parse_args(3, missing) == -1 && std::strstr(parser.error(), "device") &&
+                      parser.parse_args(3, unknown) == -1 && std::strstr(parser.error(), "--nope") &&
+                      parser.parse_args(4, bad_int) == -1 && std::strstr(parser.error(), "Invalid integer");
+            return ok && g_allocations.load() == before;
+        });
+        
+        run_test("Accepts the same numbers as ArgumentParser", [&]() {
+            const char* tokens[] = {" 5", "+5", "1e5", "inf", "nan", "0x10", "5.", "-", "7", "-3", "-2.5", ".5",
+                                    "1000000000000000000000000000000000000000000000",
+                                    "-1000000000000000000000000000000000000000000000"};
+            for (const char* token : tokens) {
+                StaticParser<6> fixed("agent");
+                fixed.add_argument("--n", nullptr, "N", INT);
+                fixed.add_argument("--f", nullptr, "F", FLOAT);
+                ArgumentParser dynamic("agent");
+                dynamic.add_argument({"--n"}, "N", INT);
+                dynamic.add_argument({"--f"}, "F", FLOAT);
+                BufferSink err;
+                dynamic.set_error_output(&err);
+                for (const char* opt : {"--n", "--f"}) {
+                    const char* argv[] = {"agent", opt, token};
+                    std::vector<std::string> args(argv, argv + 3);
+                    if ((fixed.parse_args(3, argv) == 0) != (dynamic.parse_args(args) == 0)) return false;
+                }
+            }
+            // Too many digits for float: rejected rather than stored as inf
+            StaticParser<1> fixed("agent");
+            fixed.add_argument("--f", nullptr, "F", FLOAT);
+            ArgumentParser dynamic("agent");
+            dynamic.add_argument({"--f"}, "F", FLOAT);
+            const char* argv[] = {"agent", "--f", tokens[12]};
+            std::vector<std::string> args(argv, argv + 3);
+            return fixed.parse_args(3, argv) == -1 && dynamic.parse_args(args) == -1;
+        });
+        
+        run_test("Capacity limits and invalid definitions", [&]() {
+            StaticParser<2> parser;
+            bool ok = parser.add_argument("--a", nullptr, "A") == 0 && parser.add_argument("b", nullptr, "B", STR) == 1 &&
+                      parser.add_argument("--c", nullptr, "C") == -1 && parser.size() == 2;
+            StaticParser<4> other;
+            ok = ok && other.add_argument("--x", nullptr, "X", INT, "1", true) == -1 &&
+                 other.add_argument("flag", nullptr, "F", BOOL) == -1 &&
+                 other.set_range("missing", 0, 1) == -1 && other.get<int>("missing") == 0;
+            const char* argv[] = {"p", "--", "-5"};
+            StaticParser<1> neg;
+            neg.add_argument("value", nullptr, "V", INT);
+            return ok && neg.parse_args(3, argv) == 0 && neg.get<int>("value") == -5;
+        });
+    }
+    
+    void test_output_sink() {
+        print_test_header("Output Sinks");
+        
+        run_test("Help and print_args go to the output sink", [&]() {
+            ArgumentParser parser("sinky", "Sink test");
+            parser.add_argument({"-n", "--count"}, "Repeat count", INT, "3");
+            parser.add_argument({"--rate"}, "Rate", FLOAT, "0.5");
+            BufferSink out;
+            parser.set_output(&out);
+            std::vector<std::string> args = {"sinky", "--count", "7"};
+            std::string leaked = capture_stdout([&]() {
+                parser.print_help();
+                parser.parse_args(args);
+                parser.print_args();
+            });
+            return leaked.empty() && out.str().find("Repeat count") != std::string::npos &&
+                   out.str().find("count: <int> 7\n") != std::string::npos &&
+                   out.str().find("rate: <float> 0.500000\n") != std::string::npos;
+        });
+        
+        run_test("Parse errors go to the error sink", [&]() {
+            ArgumentParser parser("sinky");
+            parser.add_argument({"--count"}, "Count", INT);
+            BufferSink err;
+            parser.set_error_output(&err);
+            std::vector<std::string> bad = {"sinky", "--count", "x"};
+            bool ok = parser.parse_args(bad) == -1 &&
+                      err.str().rfind("Argument parsing error: ", 0) == 0 && err.str().back() == '\n';
+            err.clear();
+            ok = ok && parser.parse_command_line("--count 'open") == -1 && !err.str().empty();
+            // nullptr restores the default sink
+            parser.set_error_output(nullptr);
+            return ok && &parser.error_output() != &err;
+        });
+        
+        run_test("Stream and FILE* sinks", [&]() {
+            std::ostringstream os;
+            StreamSink<std::ostream> stream(os);
+            ArgumentParser parser("sinky");
+            parser.add_argument({"--flag"}, "A flag", BOOL);
+            parser.set_output(&stream);
+            parser.print_help();
+            FILE* tmp = tmpfile();
+            FileSink file(tmp);
+            file.write("abc");
+            fflush(tmp);
+            bool ok = os.str().find("A flag") != std::string::npos && ftell(tmp) == 3;
+            fclose(tmp);
+            return ok;
+        });
+        
+        run_test("Fd sink writes to its descriptor", [&]() {
+            std::string out = capture_stdout([&]() { FdSink(1).write("via fd\n"); });
+            return out == "via fd\n";
+        });
+        
+        run_test("C interface keeps parse errors in spec_error", [&]() {
+            argparse_spec* spec = argparse_spec_new("tool", nullptr);
+            const char* aliases[] = {"--n"};
+            argparse_spec_add(spec, aliases, 1, "N", ARGPARSE_INT, "1", 0, nullptr, 0, nullptr);
+            const char* argv[] = {"tool", "--n", "nope"};
+            argparse_result* res = nullptr;
+            bool ok = argparse_parse(spec, 3, argv, &res) == -1 && res == nullptr &&
+                      std::string(argparse_spec_error(spec)).find("nope") != std::string::npos;
+            argparse_spec_free(spec);
+            return ok;
+        });
+    }
+    
+    void test_parallel_conversion() {
+        print_test_header("Parallel List Conversion");
+        
+        auto make_args = [](size_t n, const char* opt) {
+            std::vector<std::string> args = {"prog", opt};
+            for (size_t i = 0; i < n; i++) args.push_back(std::to_string((int)i - 5000));
+            return args;
+        };
+        
+        run_test("Parallel result matches serial", [&]() {
+            std::vector<std::string> args = make_args(50000, "--ints");
+            args.push_back("--floats");
+            for (int i = 0; i < 20000; i++) args.push_back(std::to_string(i) + ".5");
+            ArgumentParser serial("prog"), parallel("prog");
+            for (ArgumentParser* p : {&serial, &parallel}) {
+                p->add_argument({"--ints"}, "Ints", INT, "", false, "", {}, "", "*");
+                p->add_argument({"--floats"}, "Floats", FLOAT, "", false, "", {}, "", "+");
+                p->set_range("ints", -5000, 100000);
+            }
+            serial.set_parallel_conversion(0);
+            parallel.set_parallel_conversion(1000, 4);
+            return serial.parse_args(args) == 0 && parallel.parse_args(args) == 0 &&
+                   serial.get_list<int>("ints") == parallel.get_list<int>("ints") &&
+                   serial.get_list<float>("floats") == parallel.get_list<float>("floats") &&
+                   parallel.get_list<int>("ints").size() == 50000;
+        });
+        
+        run_test("First invalid token is reported", [&]() {
+            std::vector<std::string> args = make_args(40000, "--ints");
+            args[2 + 39000] = "late";       // in the last chunk
+            args[2 + 12345] = "early";      // in an earlier chunk
+            ArgumentParser parser("prog");
+            parser.add_argument({"--ints"}, "Ints", INT, "", false, "", {}, "", "*");
+            parser.set_parallel_conversion(1000, 4);
+            BufferSink err;
+            parser.set_error_output(&err);
+            return parser.parse_args(args) == -1 && err.str().find("early") != std::string::npos &&
+                   err.str().find("late") == std::string::npos;
+        });
+        
+        run_test("Conversion falls back when threads cannot be created", [&]() {
+            std::vector<std::string> args = make_args(40000, "--ints");
+            ArgumentParser serial("prog"), parallel("prog");
+            for (ArgumentParser* p : {&serial, &parallel}) {
+                p->add_argument({"--ints"}, "Ints", INT, "", false, "", {}, "", "*");
+            }
+            serial.set_parallel_conversion(0);
+            parallel.set_parallel_conversion(1000, 4);
+            bool ok = serial.parse_args(args) == 0;
+            for (int budget : {1, 0}) {
+                g_thread_budget = budget;
+                ok = ok && parallel.parse_args(args) == 0 &&
+                     parallel.get_list<int>("ints") == serial.get_list<int>("ints");
+                g_thread_budget = -1;
+            }
+            args[2 + 30000] = "bad";
+            g_thread_budget = 1;
+            ok = ok && parallel.parse_args(args) == -1;
+            g_thread_budget = -1;
+            return ok;
+        });
+        
+        run_test("Validators keep lists on one thread", [&]() {
+            std::vector<std::string> args = make_args(20000, "--ints");
+            ArgumentParser parser("prog");
+            parser.add_argument({"--ints"}, "Ints", INT, "", false, "", {}, "", "*");
+            size_t calls = 0;   // unsynchronized on purpose
+            parser.set_validator("ints", [&](const std::string&) { calls++; return true; });
+            parser.set_parallel_conversion(1000, 4);
+            return parser.parse_args(args) == 0 && calls == 20000;
+        });
+    }
+    
+    void test_result_pool() {
+        print_test_header("Result Pools");
+        
+        auto setup = [](ArgumentParser& parser) {
+            parser.add_argument({"--port"}, "Port", INT, "80");
+            parser.add_argument({"--host"}, "Host", STR, "localhost");
+            parser.add_argument({"--tags"}, "Tags", STR, "", false, "", {}, "", "*");
+            parser.add_argument({"file"}, "File", STR);
+        };
+        
+        run_test("Parse into pooled results", [&]() {
+            ArgumentParser parser("srv");
+            setup(parser);
+            ResultPool pool;
+            std::vector<std::string> first = {"srv", "one.txt", "--port", "8080", "--tags", "a", "b"};
+            std::vector<std::string> second = {"srv", "two.txt"};
+            bool ok;
+            {
+                ResultPool::Handle r = pool.acquire();
+                ok = parser.parse_args(first, *r) == 0 && r->get<int>("port") == 8080 &&
+                     r->get<std::vector<std::string>>("tags").size() == 2 && r->pos_args.size() == 1 &&
+                     !parser.has_argument("port");
+                r.reset();
+                ok = ok && !r && pool.stats().free == 1 && pool.stats().in_use == 0;
+            }
+            return ok;
+        });
+        
+        run_test("Recycled results are reset in place", [&]() {
+            ArgumentParser parser("srv");
+            setup(parser);
+            std::vector<std::string> full = {"srv", "--port", "8080", "--host", "h", "f1"};
+            std::vector<std::string> bare = {"srv"};
+            ResultPool& pool = ResultPool::local();
+            { auto r = pool.acquire(); parser.parse_args(full, *r); }
+            auto r = pool.acquire();
+            bool stale_hidden = r->pos_args.empty() && r->command.empty();
+            try { r->get<int>("port"); stale_hidden = false; } catch (const std::runtime_error&) {}
+            // "file" has no default: a key left over from the last request must not survive
+            bool ok = parser.parse_args(bare, *r) == 0 && r->get<int>("port") == 80 &&
+                      r->get<std::string>("host") == "localhost" && r->args.count("file") == 1;
+            return stale_hidden && ok;
+        });
+        
+        run_test("Hit rate and high-water mark", [&]() {
+            ArgumentParser parser("srv");
+            setup(parser);
+            std::vector<std::string> args = {"srv", "--port", "1", "f"};
+            ResultPool pool(2);
+            {
+                auto a = pool.acquire(), b = pool.acquire(), c = pool.acquire();
+                parser.parse_args(args, *a);
+            }   // three released; the free list keeps two
+            for (int i = 0; i < 8; i++) {
+                auto r = pool.acquire();
+                parser.parse_args(args, *r);
+            }
+            ResultPool::Stats st = pool.stats();
+            return st.acquired == 11 && st.hits == 8 && st.hit_rate() > 0.7 && st.high_water == 3 &&
+                   st.in_use == 0 && st.free == 2;
+        });
+        
+        run_test("Steady-state parse allocates only values", [&]() {
+            ArgumentParser parser("srv");
+            setup(parser);
+            std::vector<std::string> args = {"srv", "--port", "8080", "--host", "h", "--tags", "x", "y", "f"};
+            for (int i = 0; i < 3; i++) {
+                auto r = ResultPool::local().acquire();
+                parser.parse_args(args, *r);
+            }
+            size_t before = g_allocations.load();
+            { auto r = ResultPool::local().acquire(); parser.parse_args(args, *r); }
+            size_t pooled = g_allocations.load() - before;
+            before = g_allocations.load();
+            { parser.parse_args(args); CommandResult_t r = parser.take_result(); }
+            size_t fresh = g_allocations.load() - before;
+            return pooled <= 1 && fresh > pooled;   // the tags vector
+        });
+    }
+    
+    void test_stream_parser() {
+        print_test_header("Stream Parser");
+        
+        auto setup = [](ArgumentParser& parser) {
+            parser.add_argument({"job"}, "Job name", STR, "", true);
+            parser.add_argument({"--args"}, "Job arguments", STR, "", false, "", {}, "", "*");
+            parser.add_argument({"-n"}, "Count", INT, "1");
+        };
+        
+        run_test("Commands split across arbitrary chunks", [&]() {
+            ArgumentParser parser("jobs");
+            setup(parser);
+            std::vector<std::string> seen;
+            StreamParser stream(parser, [&](const ArgumentParser& p) {
+                std::string line = p.get<std::string>("job") + ":" + std::to_string(p.get<int>("n"));
+                for (const auto& a : p.get_list<std::string>("args")) line += "|" + a;
+                seen.push_back(line);
+                return 0;
+            });
+            std::string input = "build -n 2 --args 'a b' \"c\\\"d\"\n\n"
+                                "test --args 'multi\nline' x\\\n y\n"
+                                "deploy";
+            for (size_t i = 0; i < input.size(); i += 3) {
+                stream.feed(std::string_view(input).substr(i, 3));
+            }
+            bool before_finish = seen.size() == 2;
+            stream.finish();
+            return before_finish && seen.size() == 3 && stream.commands() == 3 &&
+                   seen[0] == "build:2|a b|c\"d" && seen[1] == "test:1|multi\nline|x|y" && seen[2] == "deploy:1";
+        });
+        
+        run_test("Errors skip a command, handler result stops the stream", [&]() {
+            ArgumentParser parser("jobs");
+            setup(parser);
+            BufferSink err;
+            parser.set_error_output(&err);
+            int handled = 0;
+            StreamParser stream(parser, [&](const ArgumentParser& p) {
+                handled++;
+                return p.get<std::string>("job") == "stop" ? 7 : 0;
+            });
+            int r = stream.feed("a -n x\nb\nstop\nnever\n");
+            bool ok = r == 7 && handled == 2 && stream.errors() == 1 && stream.feed("c\n") == 7;
+            stream.reset();
+            ok = ok && stream.feed("d 'open") == 0 && stream.finish() == -1 && stream.errors() == 2 &&
+                 err.str().find("No closing quotation") != std::string::npos;
+            return ok && handled == 2;
+        });
+        
+        run_test("Reads commands from a Unix socket", [&]() {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return false;
+            std::thread writer([fd = fds[1]]() {
+                const char* parts[] = {"alpha --ar", "gs 'one ", "two'\nbeta -n", " 5\n", "gamma"};
+                for (const char* part : parts) {
+                    if (write(fd, part, strlen(part)) < 0) break;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+                close(fd);
+            });
+            ArgumentParser parser("jobs");
+            setup(parser);
+            std::vector<std::string> jobs;
+            int total = 0;
+            StreamParser stream(parser, [&](const ArgumentParser& p) {
+                jobs.push_back(p.get<std::string>("job"));
+                total += p.get<int>("n") + (int)p.get_list<std::string>("args").size();
+                return 0;
+            });
+            int r = stream.run(fds[0]);
+            writer.join();
+            close(fds[0]);
+            return r == 0 && jobs == std::vector<std::string>{"alpha", "beta", "gamma"} && total == 1 + 1 + 5 + 1;
+        });
+    }
+    
+    void test_files_from() {
+        print_test_header("Files-from Lists");
+        
+        char tmpl[] = "/tmp/argparse_list_XXXXXX";
+        int fd = mkstemp(tmpl);
+        const char list[] = "a.txt\0dir/b c.txt\0\0last";
+        if (fd >= 0) {
+            if (write(fd, list, sizeof(list) - 1) < 0) {}
+            close(fd);
+        }
+        std::string list_file = tmpl;
+        
+        // Run fn with fd 0 reading what writer() produces on a pipe
+        auto with_stdin = [](std::function<void(int)> writer, std::function<bool()> fn) {
+            int p[2];
+            if (pipe(p) != 0) return false;
+            int saved = dup(0);
+            dup2(p[0], 0);
+            close(p[0]);
+            std::thread t([&]() { writer(p[1]); close(p[1]); });
+            bool ok = fn();
+            t.join();
+            dup2(saved, 0);
+            close(saved);
+            return ok;
+        };
+        
+        run_test("NUL-delimited list from a mapped file", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_argument({"--files-from"}, "List file", PATH);
+            parser.set_files_from("files_from", '\0');
+            std::vector<std::string> args = {"tool", "--files-from", list_file};
+            if (parser.parse_args(args) != 0) return false;
+            ArrayView<std::string_view> files = parser.get_file_list("files_from");
+            std::vector<std::string> missing = {"tool", "--files-from", "/nonexistent/list"};
+            ArgumentParser plain("tool");
+            plain.add_argument({"--x"}, "X", STR);
+            bool not_list = false;
+            try { plain.get_file_list("x"); } catch (const std::runtime_error&) { not_list = true; }
+            return files.size() == 3 && files[0] == "a.txt" && files[1] == "dir/b c.txt" && files[2] == "last" &&
+                   parser.get<std::string>("files_from") == list_file && parser.parse_args(missing) == -1 && not_list;
+        });
+        
+        run_test("Newline list streamed from stdin across blocks", [&]() {
+            const size_t n = 200000;     // ~2.5 MB: several read blocks
+            ArgumentParser parser("tool");
+            parser.add_argument({"--files-from"}, "List file", PATH);
+            parser.set_files_from("files_from");
+            bool ok = with_stdin([&](int out) {
+                std::string chunk;
+                for (size_t i = 0; i < n; i++) {
+                    chunk += "/data/file_" + std::to_string(i) + "\n";
+                    if (chunk.size() > 8000) {
+                        if (write(out, chunk.data(), chunk.size()) < 0) return;
+                        chunk.clear();
+                    }
+                }
+                if (write(out, chunk.data(), chunk.size()) < 0) return;
+            }, [&]() {
+                std::vector<std::string> args = {"tool", "--files-from", "-"};
+                return parser.parse_args(args) == 0;
+            });
+            ArrayView<std::string_view> files = parser.get_file_list("files_from");
+            bool all = files.size() == n;
+            for (size_t i = 0; all && i < n; i += 997) {
+                all = files[i] == "/data/file_" + std::to_string(i);
+            }
+            return ok && all && files[n - 1] == "/data/file_" + std::to_string(n - 1);
+        });
+        
+        run_test("Visitor streams entries without storing them", [&]() {
+            size_t count = 0, bytes = 0;
+            ArgumentParser parser("tool");
+            parser.add_argument({"--files-from"}, "List file", PATH);
+            parser.set_files_from("files_from", '\0', [&](std::string_view entry) {
+                if (entry == "bad") throw ArgParseException("rejected entry: bad");
+                count++;
+                bytes += entry.size();
+            });
+            std::string big(3 << 20, 'x');      // one entry longer than a read block
+            bool ok = with_stdin([&](int out) {
+                std::string data = "one";
+                data += '\0';
+                data += big;
+                data += '\0';
+                data += "two";
+                size_t off = 0;
+                while (off < data.size()) {
+                    ssize_t w = write(out, data.data() + off, std::min<size_t>(65536, data.size() - off));
+                    if (w <= 0) return;
+                    off += (size_t)w;
+                }
+            }, [&]() {
+                std::vector<std::string> args = {"tool", "--files-from", "-"};
+                return parser.parse_args(args) == 0;
+            });
+            ok = ok && count == 3 && bytes == 6 + big.size() && parser.get_file_list("files_from").empty();
+            BufferSink err;
+            parser.set_error_output(&err);
+            bool rejected = with_stdin([](int out) { if (write(out, "a\0bad\0c", 7) < 0) {} }, [&]() {
+                std::vector<std::string> args = {"tool", "--files-from", "-"};
+                return parser.parse_args(args) == -1;
+            });
+            return ok && rejected && err.str().find("rejected entry") != std::string::npos;
+        });
+        
+        unlink(list_file.c_str());
+    }
+    
+    void test_positional_nargs() {
+        print_test_header("Positional Nargs");
+        
+        run_test("src+ dst with options intermixed", [&]() {
+            ArgumentParser parser("cp");
+            parser.add_argument({"src"}, "Sources", STR, "", true, "", {}, "", "+");
+            parser.add_argument({"dst"}, "Destination", STR, "", true);
+            parser.add_argument({"--level"}, "Level", INT);
+            parser.add_argument({"--verbose"}, "Verbose", BOOL);
+            std::vector<std::string> args = {"cp", "a", "b", "--level", "3", "c", "--verbose", "d"};
+            if (parser.parse_args(args) != 0) return false;
+            std::vector<std::string> src = parser.get_list<std::string>("src");
+            return src == std::vector<std::string>{"a", "b", "c"} && parser.get<std::string>("dst") == "d" &&
+                   parser.get<int>("level") == 3 && parser.get<bool>("verbose");
+        });
+        
+        run_test("files* out accepts zero files", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_argument({"files"}, "Inputs", INT, "", true, "", {}, "", "*");
+            parser.add_argument({"out"}, "Output", STR, "", true);
+            std::vector<std::string> none = {"tool", "out.bin"};
+            if (parser.parse_args(none) != 0 || !parser.get_list<int>("files").empty()) return false;
+            std::vector<std::string> some = {"tool", "1", "-2", "3", "out.bin"};
+            return parser.parse_args(some) == 0 && parser.get_list<int>("files") == std::vector<int>{1, -2, 3} &&
+                   parser.get<std::string>("out") == "out.bin";
+        });
+        
+        run_test("Fixed count and optional positional", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_argument({"pair"}, "Pair", INT, "", true, "", {}, "", "2");
+            parser.add_argument({"extra"}, "Extra", STR, "", false, "", {}, "", "?");
+            std::vector<std::string> two = {"tool", "1", "2"};
+            if (parser.parse_args(two) != 0 || !parser.get_list<std::string>("extra").empty()) return false;
+            std::vector<std::string> three = {"tool", "1", "2", "x"};
+            return parser.parse_args(three) == 0 && parser.get_list<int>("pair") == std::vector<int>{1, 2} &&
+                   parser.get_list<std::string>("extra") == std::vector<std::string>{"x"};
+        });
+        
+        run_test("Later minimums are reserved without required", [&]() {
+            ArgumentParser cp("cp");
+            cp.add_argument({"src"}, "Sources", STR, "", false, "", {}, "", "+");
+            cp.add_argument({"dst"}, "Destination", STR);
+            std::vector<std::string> three = {"cp", "a", "b", "c"};
+            if (cp.parse_args(three) != 0 || cp.get_list<std::string>("src") != std::vector<std::string>{"a", "b"} ||
+                cp.get<std::string>("dst") != "c") return false;
+            ArgumentParser tool("tool");
+            tool.add_argument({"files"}, "Inputs", STR, "", false, "", {}, "", "*");
+            tool.add_argument({"out"}, "Output", STR, "a.out");
+            if (tool.parse_args(three) != 0 || tool.get_list<std::string>("files") != std::vector<std::string>{"a", "b"} ||
+                tool.get<std::string>("out") != "c") return false;
+            std::vector<std::string> none = {"tool"};
+            return tool.parse_args(none) == 0 && tool.get_list<std::string>("files").empty() &&
+                   tool.get<std::string>("out") == "a.out";
+        });
+        
+        run_test("Too few tokens fill positionals in order", [&]() {
+            ArgumentParser parser("tool");
+            parser.add_argument({"first"}, "First", STR, "x");
+            parser.add_argument({"second"}, "Second", STR, "y");
+            std::vector<std::string> one = {"tool", "a"};
+            return parser.parse_args(one) == 0 && parser.get<std::string>("first") == "a" &&
+                   parser.get<std::string>("second") == "y";
+        });
+        
+        run_test("Too few tokens are reported", [&]() {
+            BufferSink err;
+            ArgumentParser cp("cp");
+            cp.set_error_output(&err);
+            cp.add_argument({"src"}, "Sources", STR, "", true, "", {}, "", "+");
+            cp.add_argument({"dst"}, "Destination", STR, "", true);
+            std::vector<std::string> one = {"cp", "a"};
+            bool missing = cp.parse_args(one) == -1 && err.str().find("Missing required positional argument: dst") != std::string::npos;
+            ArgumentParser pair("tool");
+            pair.set_error_output(&err);
+            pair.add_argument({"pair"}, "Pair", INT, "", true, "", {}, "", "2");
+            std::vector<std::string> short_args = {"tool", "1"};
+            bool too_few = pair.parse_args(short_args) == -1 &&
+                           err.str().find("Not enough values for argument pair (expected 2)") != std::string::npos;
+            return missing && too_few;
+        });
+        
+        run_test("One million positional tokens", [&]() {
+            const size_t n = 1000000;
+            std::vector<std::string> args = {"tool"};
+            args.reserve(n + 3);
+            for (size_t i = 0; i < n; i++) {
+                args.push_back(std::to_string(i));
+            }
+            args.push_back("--");
+            args.push_back("-out");
+            ArgumentParser parser("tool");
+            parser.add_argument({"head"}, "Head", INT, "", true);
+            parser.add_argument({"rest"}, "Rest", INT, "", true, "", {}, "", "*");
+            parser.add_argument({"out"}, "Output", STR, "", true);
+            if (parser.parse_args(args) != 0) return false;
+            std::vector<int> rest = parser.get_list<int>("rest");
+            return parser.get<int>("head") == 0 && rest.size() == n - 1 && rest.back() == (int)n - 1 &&
+                   parser.get<std::string>("out") == "-out";
+        });
+    }
+    
     void run_all_tests() {
         std::cout << "ArgParse Library - Unified Test Suite" << std::endl;
         std::cout << std::string(60, '=') << std::endl;
@@ -1004,6 +2802,28 @@ public:
         test_boundary_values();
         test_error_message_validation();
         test_performance_stress();
+        test_range_validators();
+        test_regex_patterns();
+        test_path_arguments();
+        test_glob_expansion();
+        test_file_and_blob_arguments();
+        test_binary_arrays();
+        test_command_line_tokenizer();
+        test_repl_and_completion();
+        test_command_chains();
+        test_action_callbacks();
+        test_help_fast_path();
+        test_help_search();
+        test_argument_groups();
+        test_help_resource();
+        test_c_api();
+        test_static_parser();
+        test_output_sink();
+        test_parallel_conversion();
+        test_result_pool();
+        test_stream_parser();
+        test_files_from();
+        test_positional_nargs();
         
         std::cout << "\n" << std::string(60, '=') << std::endl;
         std::cout << "FINAL RESULTS" << std::endl;